@@ -0,0 +1,51 @@
+# frozen_string_literal: true
+
+# Compare two results of the execution benchmark, usually from two different
+# commits, showing how much each metric of each case changed. It exits with an
+# error when the ips dropped, or the allocations grew, more than the threshold.
+#
+# Usage: compare.rb [--threshold PERCENT] BEFORE.json AFTER.json
+
+require 'json'
+require 'optparse'
+
+threshold = 5.0
+OptionParser.new do |opts|
+  opts.banner = 'Usage: compare.rb [options] BEFORE.json AFTER.json'
+  opts.on('--threshold PERCENT', Float, 'The change considered a regression') { |v| threshold = v }
+end.parse!
+
+abort('Two result files are required') unless ARGV.size == 2
+before, after = ARGV.map { |file| JSON.parse(File.read(file)) }
+indexed = before['results'].to_h { |result| [result['name'], result] }
+
+# The change from +from+ to +to+ in percent
+def change(from, to)
+  return 0.0 if from.nil? || to.nil? || from.zero?
+  (to - from) * 100.0 / from
+end
+
+puts "#{before['commit']} -> #{after['commit']}\n\n"
+puts format('%-40s %12s %12s %12s %12s %12s', 'case', 'ips', 'allocs', 'retained', 'p50', 'p99')
+
+regressions = after['results'].map do |result|
+  previous = indexed[result['name']]
+  next puts(format('%-40s %12s', result['name'], 'new')) if previous.nil?
+
+  ips = change(previous['ips'], result['ips'])
+  allocations = change(previous['allocations'], result['allocations'])
+  retained = result['retained']['objects'] - previous['retained']['objects']
+  p50 = change(previous['latency']['total']['p50'], result['latency']['total']['p50'])
+  p99 = change(previous['latency']['total']['p99'], result['latency']['total']['p99'])
+
+  regressed = ips < -threshold || allocations > threshold
+  puts format(
+    '%-40s %+11.1f%% %+11.1f%% %+12d %+11.1f%% %+11.1f%%%s',
+    result['name'], ips, allocations, retained, p50, p99, regressed ? ' !' : '',
+  )
+
+  result['name'] if regressed
+end.compact
+
+exit if regressions.empty?
+abort("\n#{regressions.size} case(s) regressed more than #{threshold}%")
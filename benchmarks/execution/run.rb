@@ -0,0 +1,241 @@
+# frozen_string_literal: true
+
+# Self-contained benchmark of the execution of requests, which runs every
+# shape of request against the in-memory and SQLite schemas of all the sizes,
+# using both the JSON and the Hash collectors. It does not need the network
+# nor any application, and writes the results to a JSON file that can be
+# compared with the one of another commit through +compare.rb+.
+#
+# Usage: run.rb [--seconds N] [--samples N] [--only PATTERN] [--output FILE]
+
+require 'bundler/setup'
+require 'json'
+require 'objspace'
+require 'optparse'
+
+require 'active_record'
+require 'rails-graphql'
+
+Rails::GraphQL.config.logger = ActiveSupport::TaggedLogging.new(Logger.new(File::NULL))
+
+require_relative 'schemas'
+require_relative 'shapes'
+
+module Benchmarks
+  module Execution
+    # The response format used to pick each of the collectors
+    COLLECTORS = { json: :string, hash: :hash }.freeze
+
+    # The events that report each phase of a request
+    PHASES = {
+      parse: 'parse.graphql',
+      organize: 'organize.graphql',
+      prepare: 'prepare.graphql',
+      resolve: 'resolve.graphql',
+      serialize: 'serialize.graphql',
+    }.freeze
+
+    class Runner
+      def initialize(seconds: 2.0, samples: 200, only: nil, output: nil)
+        @seconds = seconds
+        @samples = samples
+        @only = only
+        @output = output || default_output
+      end
+
+      # Run all the cases and write their results to the output
+      def run
+        results = cases.map do |kind, size, shape, collector|
+          name = [kind, size, shape, collector].join('/')
+          request = Execution.request_for(shape, kind, size)
+          next if request.nil? || (@only && !name.match?(@only))
+
+          schema = Execution.schema_for(kind, size)
+          call = caller_for(schema, request, COLLECTORS[collector])
+
+          result = measure(call).merge(
+            name: name, schema: kind, size: size, shape: shape, collector: collector,
+          )
+
+          report(result)
+          result
+        end
+
+        FileUtils.mkdir_p(File.dirname(@output))
+        File.write(@output, JSON.pretty_generate(meta.merge(results: results.compact)))
+        puts "\nResults written to #{@output}"
+      end
+
+      private
+
+        # All the combinations of kind, size, shape, and collector
+        def cases
+          SCHEMAS.keys.product(SIZES.keys, SHAPES.keys, COLLECTORS.keys)
+        end
+
+        # Build a callable that runs one request of the given shape
+        def caller_for(schema, request, format)
+          document, variables = request.values_at(:document, :variables)
+          variables ||= {}
+
+          call =
+            if request[:subscription]
+              -> { subscribe_and_update(schema, document, format) }
+            else
+              -> { Rails::GraphQL::Request.execute(document, schema: schema, variables: variables, as: format) }
+            end
+
+          check!(call.call)
+          call
+        end
+
+        # Subscribe, broadcast one update, and then remove the subscription
+        def subscribe_and_update(schema, document, format)
+          request = Rails::GraphQL::Request.new(schema)
+          result = request.execute(document, as: format)
+          sids = request.subscriptions.keys
+
+          sids.each { |sid| schema.subscription_provider.update(sid, as: format) }
+          sids.each { |sid| schema.delete_from_cache(sid) }
+          schema.remove_subscriptions(*sids)
+          result
+        end
+
+        # Make sure that the request is measuring a successful execution
+        def check!(result)
+          result = JSON.parse(result) if result.is_a?(String)
+          errors = result['errors'] || result[:errors]
+          raise "The request failed: #{errors.inspect}" if errors.present?
+        end
+
+        # Collect everything for one case
+        def measure(call)
+          run_for(@seconds / 4, call)
+
+          iterations, elapsed = run_for(@seconds, call)
+          {
+            ips: (iterations / elapsed).round(2),
+            iterations: iterations,
+            allocations: allocations(call),
+            retained: retained(call),
+            latency: latency(call),
+          }
+        end
+
+        # Run the call as many times as possible in the given number of
+        # seconds, returning how many it ran and how long it took
+        def run_for(seconds, call)
+          iterations = 0
+          started_at = clock
+          finish_at = started_at + seconds
+
+          begin
+            call.call
+            iterations += 1
+          end while clock < finish_at
+
+          [iterations, clock - started_at]
+        end
+
+        # The number of objects allocated by each request
+        def allocations(call)
+          before = GC.stat(:total_allocated_objects)
+          @samples.times { call.call }
+          (GC.stat(:total_allocated_objects) - before) / @samples
+        end
+
+        # The objects and bytes still alive after all the samples ran, which
+        # should be zero when the requests don't leak anything
+        def retained(call)
+          GC.start(full_mark: true, immediate_sweep: true)
+          objects, bytes = live_objects, ObjectSpace.memsize_of_all
+
+          @samples.times { call.call }
+
+          GC.start(full_mark: true, immediate_sweep: true)
+          { objects: live_objects - objects, bytes: ObjectSpace.memsize_of_all - bytes }
+        end
+
+        # The p50 and p99 of the whole request and each of its phases, in
+        # milliseconds, from the events they instrument
+        def latency(call)
+          durations = Hash.new { |hash, key| hash[key] = [] }
+          subscribers = PHASES.map do |phase, event|
+            ActiveSupport::Notifications.subscribe(event) do |*args|
+              durations[phase] << ActiveSupport::Notifications::Event.new(*args).duration
+            end
+          end
+
+          @samples.times do
+            started_at = clock
+            call.call
+            durations[:total] << (clock - started_at) * 1000
+          end
+
+          durations.transform_values do |list|
+            list.sort!
+            { p50: percentile(list, 0.5).round(4), p99: percentile(list, 0.99).round(4) }
+          end
+        ensure
+          subscribers&.each { |subscriber| ActiveSupport::Notifications.unsubscribe(subscriber) }
+        end
+
+        def percentile(sorted, ratio)
+          sorted[((sorted.size - 1) * ratio).round]
+        end
+
+        def live_objects
+          counts = ObjectSpace.count_objects
+          counts[:TOTAL] - counts[:FREE]
+        end
+
+        def clock
+          Process.clock_gettime(Process::CLOCK_MONOTONIC)
+        end
+
+        def report(result)
+          total = result[:latency][:total]
+          puts format(
+            '%-40s %10.1f ips %8d allocs %8d retained %9.3f p50 %9.3f p99',
+            result[:name], result[:ips], result[:allocations], result[:retained][:objects],
+            total[:p50], total[:p99],
+          )
+        end
+
+        # Identify where and with what the results were collected
+        def meta
+          {
+            commit: git('rev-parse HEAD'),
+            branch: git('rev-parse --abbrev-ref HEAD'),
+            created_at: Time.now.utc.iso8601,
+            ruby: RUBY_DESCRIPTION,
+            rails: ActiveSupport.version.to_s,
+            version: Rails::GraphQL.version,
+            seconds: @seconds,
+            samples: @samples,
+          }
+        end
+
+        def default_output
+          name = "execution-#{git('rev-parse --short HEAD') || 'unknown'}.json"
+          File.expand_path("../../tmp/benchmark/#{name}", __dir__)
+        end
+
+        def git(command)
+          result = `git -C #{__dir__} #{command} 2>/dev/null`.strip
+          result unless result.empty?
+        end
+    end
+  end
+end
+
+options = {}
+OptionParser.new do |opts|
+  opts.banner = 'Usage: run.rb [options]'
+  opts.on('--seconds N', Float, 'How long to measure the ips of each case') { |v| options[:seconds] = v }
+  opts.on('--samples N', Integer, 'How many requests to sample for the other metrics') { |v| options[:samples] = v }
+  opts.on('--only PATTERN', Regexp, 'Only run the cases with matching names') { |v| options[:only] = v }
+  opts.on('--output FILE', 'Where to write the results') { |v| options[:output] = v }
+end.parse!
+
+Benchmarks::Execution::Runner.new(**options).run
@@ -0,0 +1,215 @@
+# frozen_string_literal: true
+
+require 'active_record'
+require 'active_support/cache'
+
+module Benchmarks
+  module Execution
+    # The sizes of the schemas, as in how many extra types they define, which
+    # makes the type map bigger, and how many records the lists return
+    SIZES = {
+      small:  { types: 5,   records: 10 },
+      medium: { types: 25,  records: 100 },
+      large:  { types: 100, records: 1_000 },
+    }.freeze
+
+    # How deep the chain of records used to test deep nesting goes
+    DEPTH = 10
+
+    # A subscription provider that keeps everything in the process, so that
+    # subscribing and broadcasting can run without ActionCable
+    class Provider < Rails::GraphQL::Subscription::Provider::Base
+      def accepts?(*)
+        true
+      end
+
+      def add(*subscriptions)
+        subscriptions.each { |item| store.add(item) }
+      end
+
+      def async_remove(item)
+        store.remove(item) unless (item = store.fetch(item)).nil?
+      end
+
+      def async_update(item, data = nil, **xargs)
+        return if (item = store.fetch(item)).nil?
+
+        data = execute(item, **xargs) if data.nil?
+        store.update!(item)
+        data
+      end
+    end
+
+    # A plain Ruby record of the in-memory schemas
+    Node = Struct.new(:dataset, :id, :name, :position, :score, :active, :tags) do
+      def child
+        dataset[(position + 1) % dataset.size]
+      end
+
+      def children
+        Array.new([dataset.size, 5].min) { |idx| dataset[(position + idx + 1) % dataset.size] }
+      end
+    end
+
+    # Hold the schemas by their kind and size
+    SCHEMAS = { memory: {}, sqlite: {} }
+
+    # The base class of all the records of the SQLite schemas
+    class Record < ActiveRecord::Base
+      self.abstract_class = true
+
+      establish_connection(adapter: 'sqlite3', database: ':memory:')
+    end
+
+    class << self
+      # Build all the schemas of the given kind and size
+      def schema_for(kind, size)
+        SCHEMAS[kind][size] ||= send(:"build_#{kind}_schema", size, SIZES.fetch(size))
+      end
+
+      # Get the name of the root fields of the SQLite schema of the given size,
+      # as in +benchSmallItems+
+      def sqlite_prefix(size)
+        "bench#{size.to_s.camelize}"
+      end
+
+      private
+
+        # Define a number of extra types that are never requested, but they
+        # still make the type map and the introspection bigger
+        def build_filler_types(schema, count)
+          schema.class_eval do
+            count.times do |idx|
+              object("Filler#{idx}") do
+                10.times { |field| field(:"field#{field}", :string) }
+              end
+            end
+          end
+        end
+
+        # Shared settings of all the schemas
+        def configure_schema(schema)
+          schema.configure do |config|
+            config.enable_string_collector = true
+            config.default_response_format = :string
+            config.cache = ActiveSupport::Cache::MemoryStore.new
+            config.subscription_provider = Provider.new
+          end
+        end
+
+        def build_memory_schema(size, settings)
+          dataset = []
+          settings[:records].times do |idx|
+            tags = Array.new(3) { |tag| "tag-#{(idx + tag) % 7}" }
+            dataset << Node.new(dataset, (idx + 1).to_s, "Node #{idx + 1}", idx, idx / 3.0, idx.even?, tags)
+          end
+
+          schema = Execution.const_set(:"Memory#{size.to_s.camelize}Schema", Class.new(Rails::GraphQL::Schema))
+
+          schema.class_eval do
+            namespace :"bench_memory_#{size}"
+
+            object 'Node' do
+              field :id, :id, null: false
+              field :name, :string
+              field :position, :int
+              field :score, :float
+              field :active, :boolean
+              field :tags, :string, array: true
+              field :child, 'Node'
+              field :children, 'Node', array: true
+            end
+
+            query_fields do
+              field :nodes, 'Node', array: true, method_name: :all_nodes
+              field :node, 'Node', method_name: :find_node,
+                arguments: arg(:id, :id, null: false)
+            end
+
+            mutation_fields do
+              field :rename_node, 'Node' do
+                argument :id, :id, null: false
+                argument :name, :string, null: false
+
+                perform :rename_node
+                resolve :find_node
+              end
+            end
+
+            subscription_fields do
+              field :node_changed, 'Node', method_name: :find_node,
+                arguments: arg(:id, :id, null: false)
+            end
+
+            define_method(:all_nodes) { dataset }
+            define_method(:find_node) { |id:| dataset[id.to_i - 1] }
+            define_method(:rename_node) { |id:, name:| dataset[id.to_i - 1].name = name }
+          end
+
+          configure_schema(schema)
+          build_filler_types(schema, settings[:types])
+          schema
+        end
+
+        def build_sqlite_schema(size, settings)
+          prefix = sqlite_prefix(size)
+          group_table = :"#{prefix.underscore}_groups"
+          item_table = :"#{prefix.underscore}_items"
+
+          Record.connection.instance_eval do
+            create_table(group_table, force: :cascade) do |t|
+              t.integer 'parent_id'
+              t.string 'name'
+            end
+
+            create_table(item_table, force: :cascade) do |t|
+              t.integer 'group_id'
+              t.string 'name'
+              t.integer 'position'
+              t.float 'score'
+              t.boolean 'active'
+            end
+          end
+
+          # The models live at the top level so the names of the types and
+          # fields of the sources are not prefixed with the module
+          group = Object.const_set(:"#{prefix.camelize}Group", Class.new(Record))
+          item = Object.const_set(:"#{prefix.camelize}Item", Class.new(Record))
+
+          group.class_eval do
+            self.table_name = group_table
+            belongs_to :parent, class_name: name, optional: true
+            has_many :groups, class_name: name, foreign_key: :parent_id
+            has_many :items, class_name: item.name, foreign_key: :group_id
+          end
+
+          item.class_eval do
+            self.table_name = item_table
+            belongs_to :group, class_name: group.name, optional: true
+          end
+
+          # A chain of groups for the nesting, and all the items on the first
+          parent = nil
+          DEPTH.times { |idx| parent = group.create!(name: "Group #{idx + 1}", parent: parent) }
+          rows = Array.new(settings[:records]) do |idx|
+            { group_id: 1, name: "Item #{idx + 1}", position: idx, score: idx / 3.0, active: idx.even? }
+          end
+
+          item.insert_all!(rows)
+
+          schema = Execution.const_set(:"Sqlite#{size.to_s.camelize}Schema", Class.new(Rails::GraphQL::Schema))
+
+          schema.class_eval do
+            namespace :"bench_sqlite_#{size}"
+
+            source group
+            source item
+          end
+
+          configure_schema(schema)
+          build_filler_types(schema, settings[:types])
+          schema
+        end
+    end
+  end
+end
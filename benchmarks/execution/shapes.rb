@@ -0,0 +1,106 @@
+# frozen_string_literal: true
+
+module Benchmarks
+  module Execution
+    # The shapes of the requests, which build the document and variables for
+    # each kind of schema. A shape that doesn't support a kind returns nil
+    SHAPES = {}
+
+    # The fields selected from each record
+    MEMORY_FIELDS = 'id name position score active tags'
+    SQLITE_FIELDS = 'id name position score active'
+
+    # How many fragments the request of many fragments uses
+    FRAGMENTS = 20
+
+    class << self
+      # Add a new shape of request
+      def shape(name, &block)
+        SHAPES[name] = block
+      end
+
+      # Get the document and variables of the given shape for the given kind
+      # and size of the schema
+      def request_for(name, kind, size)
+        SHAPES.fetch(name).call(kind, sqlite_prefix(size))
+      end
+
+      private
+
+        # Build a selection nested +DEPTH+ levels through the given +field+
+        def nested_selection(field, fields)
+          DEPTH.times.reduce(fields) { |inner, _| "#{fields} #{field} { #{inner} }" }
+        end
+
+        # Build a document with +FRAGMENTS+ fragments on the given +type+, all
+        # spread on the given +field+
+        def fragments_document(field, type, fields)
+          fields = fields.split
+          spreads = Array.new(FRAGMENTS) { |idx| "...f#{idx}" }.join(' ')
+          fragments = Array.new(FRAGMENTS) do |idx|
+            "fragment f#{idx} on #{type} { #{fields.rotate(idx).take(3).join(' ')} }"
+          end
+
+          "{ #{field} { #{spreads} } }\n#{fragments.join("\n")}"
+        end
+    end
+
+    # A long list of records with all their scalar fields
+    shape :wide_list do |kind, prefix|
+      case kind
+      when :memory then { document: "{ nodes { #{MEMORY_FIELDS} } }" }
+      when :sqlite then { document: "{ #{prefix}Items { #{SQLITE_FIELDS} } }" }
+      end
+    end
+
+    # One record, and then records within records up to +DEPTH+ levels
+    shape :deep_nesting do |kind, prefix|
+      case kind
+      when :memory then { document: "{ node(id: \"1\") { #{nested_selection('child', 'id name')} } }" }
+      when :sqlite then { document: "{ #{prefix}Group(id: \"1\") { #{nested_selection('groups', 'id name')} } }" }
+      end
+    end
+
+    # The list of records, selected through many small fragments
+    shape :many_fragments do |kind, prefix|
+      case kind
+      when :memory then { document: fragments_document('nodes', 'Node', MEMORY_FIELDS) }
+      when :sqlite then { document: fragments_document("#{prefix}Items", "#{prefix.camelize}Item", SQLITE_FIELDS) }
+      end
+    end
+
+    # Change one record and return it
+    shape :mutation do |kind, prefix|
+      case kind
+      when :memory
+        {
+          document: <<~GQL,
+            mutation($id: ID!, $name: String!) {
+              renameNode(id: $id, name: $name) { id name }
+            }
+          GQL
+          variables: { 'id' => '1', 'name' => 'Node 1' },
+        }
+      when :sqlite
+        {
+          document: <<~GQL,
+            mutation($id: ID!, $data: #{prefix.camelize}ItemInput!) {
+              update#{prefix.camelize}Item(id: $id, #{prefix}Item: $data) { id name }
+            }
+          GQL
+          variables: { 'id' => '1', 'data' => { 'name' => 'Item 1' } },
+        }
+      end
+    end
+
+    # Subscribe to one record, broadcast one update, and then unsubscribe
+    shape :subscription do |kind, _prefix|
+      next unless kind == :memory
+
+      {
+        document: "subscription { nodeChanged(id: \"1\") { #{MEMORY_FIELDS} } }",
+        subscription: true,
+      }
+    end
+  end
+end
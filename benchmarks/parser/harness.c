@@ -0,0 +1,147 @@
+// Standalone throughput harness for the parser, which embeds Ruby and links
+// the sources of the extension directly, so it runs without the gem or the
+// network. Build and run it with `rake benchmark:parser`.
+//
+// Usage: harness [--seconds N] FILE...
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ruby.h"
+#include "shared.h"
+
+void Init_gql_parser();
+
+// The result of running one of the modes against a document
+struct gql_bench_result
+{
+  long iterations;
+  unsigned long tokens;
+  size_t allocations;
+  double seconds;
+};
+
+double gql_bench_clock()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+size_t gql_bench_allocated()
+{
+  return rb_gc_stat(ID2SYM(rb_intern("total_allocated_objects")));
+}
+
+// Go over all the lexemes of the document without building anything. The
+// scanner does not move past single char lexemes, which is up to the parser
+unsigned long gql_bench_lex(VALUE document)
+{
+  unsigned long tokens = 0;
+  struct gql_scanner scanner = gql_new_scanner(document);
+
+  while (1)
+  {
+    scanner.lexeme = gql_i_comment;
+    gql_next_lexeme(&scanner);
+    if (scanner.lexeme == gql_i_eof)
+      break;
+
+    tokens++;
+    if (scanner.current_pos == scanner.start_pos)
+      GQL_SCAN_NEXT((&scanner));
+  }
+
+  return tokens;
+}
+
+// Run the given mode for at least the given number of seconds
+struct gql_bench_result gql_bench_run(int lex_only, VALUE parser, VALUE document, double seconds)
+{
+  struct gql_bench_result result = {0, 0, 0, 0};
+  ID parse_execution = rb_intern("parse_execution");
+  size_t allocated = gql_bench_allocated();
+  double started_at = gql_bench_clock();
+
+  do
+  {
+    for (int i = 0; i < 10; i++)
+    {
+      if (lex_only)
+        result.tokens += gql_bench_lex(document);
+      else
+        rb_funcall(parser, parse_execution, 1, document);
+    }
+
+    result.iterations += 10;
+    result.seconds = gql_bench_clock() - started_at;
+  } while (result.seconds < seconds);
+
+  result.allocations = gql_bench_allocated() - allocated;
+  return result;
+}
+
+void gql_bench_report(const char *name, const char *mode, long bytes, unsigned long tokens, struct gql_bench_result *result)
+{
+  double docs = result->iterations / result->seconds;
+  printf("%-24s %-6s %10ld %10.2f %14.0f %12.0f %10.1f\n", name, mode, bytes,
+    docs * bytes / (1024 * 1024), docs * tokens, docs, (double)result->allocations / result->iterations);
+}
+
+VALUE gql_bench_main(VALUE argv)
+{
+  double seconds = 1.0;
+  VALUE parser = rb_class_new_instance(0, NULL, rb_path2class("GQLParser::Parser"));
+  VALUE stats_key = ID2SYM(rb_intern("tokens"));
+
+  printf("%-24s %-6s %10s %10s %14s %12s %10s\n",
+    "document", "mode", "bytes", "MB/s", "tokens/s", "docs/s", "allocs/doc");
+
+  for (long i = 0; i < RARRAY_LEN(argv); i++)
+  {
+    VALUE arg = RARRAY_AREF(argv, i);
+    if (strcmp(StringValueCStr(arg), "--seconds") == 0 && i + 1 < RARRAY_LEN(argv))
+    {
+      seconds = NUM2DBL(rb_Float(RARRAY_AREF(argv, ++i)));
+      continue;
+    }
+
+    VALUE document = rb_funcall(rb_cFile, rb_intern("read"), 1, arg);
+    VALUE name = rb_funcall(rb_cFile, rb_intern("basename"), 1, arg);
+    long bytes = RSTRING_LEN(document);
+
+    // Warm up and get the number of tokens seen by the parser
+    rb_funcall(parser, rb_intern("parse_execution"), 1, document);
+    unsigned long tokens = NUM2ULONG(rb_hash_aref(rb_funcall(parser, rb_intern("stats"), 0), stats_key));
+
+    struct gql_bench_result lex = gql_bench_run(1, parser, document, seconds);
+    gql_bench_report(StringValueCStr(name), "lex", bytes, lex.tokens / lex.iterations, &lex);
+
+    struct gql_bench_result parse = gql_bench_run(0, parser, document, seconds);
+    gql_bench_report(StringValueCStr(name), "parse", bytes, tokens, &parse);
+  }
+
+  return Qnil;
+}
+
+int main(int argc, char **argv)
+{
+  int state;
+
+  ruby_init();
+  ruby_init_loadpath();
+  rb_require("delegate");
+  Init_gql_parser();
+
+  VALUE args = rb_ary_new();
+  for (int i = 1; i < argc; i++)
+    rb_ary_push(args, rb_str_new_cstr(argv[i]));
+
+  rb_protect(gql_bench_main, args, &state);
+  if (state)
+    rb_p(rb_errinfo());
+
+  return ruby_cleanup(state);
+}
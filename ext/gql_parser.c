@@ -1,5 +1,6 @@
 #include <string.h>
 #include <math.h>
+#include <time.h>
 
 #include "ruby.h"
 #include "shared.h"
@@ -8,6 +9,12 @@
 // EXECUTION DOCUMENT [OPERATION*, FRAGMENT*]
 VALUE gql_parse_execution(VALUE self, VALUE document);
 
+// EXECUTION DOCUMENT [OPERATION*, FRAGMENT*]
+VALUE gql_parse_execution_with(struct gql_parser *parser, VALUE document);
+
+// EXECUTION DOCUMENT [OPERATION*, FRAGMENT*]
+VALUE gql_parse_execution_body(VALUE args);
+
 // OPERATION [type?, name?, VARIABLE*, DIRECTIVE*, FIELD*]
 VALUE gql_parse_operation(struct gql_scanner *scanner);
 
@@ -50,9 +57,6 @@ VALUE gql_nil_and_unknown(struct gql_scanner *scanner);
 // Little helper to assign the start memoized position
 VALUE gql_token_start_from_mem(VALUE instance, unsigned long memory[2]);
 
-// Central error method
-NORETURN(void gql_throw_parser_error(struct gql_scanner *scanner));
-
 /* STRUCTURES
  *
  * EXECUTION DOCUMENT [OPERATION*, FRAGMENT*]
@@ -65,17 +69,173 @@ NORETURN(void gql_throw_parser_error(struct gql_scanner *scanner));
  * ARGUMENT [name, value?, var_name?]
  */
 
+/* PARSER INSTANCES */
+// Items of a parse in progress must be marked
+void gql_parser_mark(void *ptr)
+{
+  struct gql_parser *parser = ptr;
+  rb_gc_mark_locations(parser->arena.items, parser->arena.items + parser->arena.size);
+}
+
+void gql_parser_free(void *ptr)
+{
+  struct gql_parser *parser = ptr;
+  xfree(parser->arena.items);
+  xfree(parser);
+}
+
+size_t gql_parser_memsize(const void *ptr)
+{
+  const struct gql_parser *parser = ptr;
+  return sizeof(struct gql_parser) + parser->arena.capa * sizeof(VALUE);
+}
+
+static const rb_data_type_t gql_parser_type = {
+  "GQLParser::Parser",
+  {gql_parser_mark, gql_parser_free, gql_parser_memsize},
+  0, 0, RUBY_TYPED_FREE_IMMEDIATELY
+};
+
+static VALUE gql_total_allocated_objects;
+
+VALUE gql_parser_alloc(VALUE klass)
+{
+  struct gql_parser *parser;
+  return TypedData_Make_Struct(klass, struct gql_parser, &gql_parser_type, parser);
+}
+
+struct gql_parser *gql_parser_get(VALUE self)
+{
+  struct gql_parser *parser;
+  TypedData_Get_Struct(self, struct gql_parser, &gql_parser_type, parser);
+  return parser;
+}
+
+// The parser of the current thread, which is created on demand
+VALUE gql_parser_current(VALUE klass)
+{
+  ID key = rb_intern("gql_parser");
+  VALUE thread = rb_thread_current();
+  VALUE result = rb_thread_local_aref(thread, key);
+
+  if (NIL_P(result))
+  {
+    result = rb_class_new_instance(0, NULL, klass);
+    rb_thread_local_aset(thread, key, result);
+  }
+
+  return result;
+}
+
+// Parse an execution document reusing the arena of the parser
+VALUE gql_parser_parse_execution(VALUE self, VALUE document)
+{
+  VALUE result = gql_parse_execution_with(gql_parser_get(self), document);
+  RB_GC_GUARD(self);
+  return result;
+}
+
+// The highest number of items the arena had to hold at once
+VALUE gql_parser_peak(VALUE self)
+{
+  return LONG2NUM(gql_parser_get(self)->arena.peak);
+}
+
+// The number of items the arena can hold without growing
+VALUE gql_parser_capacity(VALUE self)
+{
+  return LONG2NUM(gql_parser_get(self)->arena.capa);
+}
+
+// The numbers of the last successful parse. The allocations come from the
+// global counter of the GC, so they include objects allocated by other threads
+// while the parse was running
+VALUE gql_parser_stats(VALUE self)
+{
+  struct gql_parser *parser = gql_parser_get(self);
+  VALUE result = rb_hash_new();
+
+  rb_hash_aset(result, ID2SYM(rb_intern("bytes")), ULONG2NUM(parser->bytes));
+  rb_hash_aset(result, ID2SYM(rb_intern("tokens")), ULONG2NUM(parser->tokens));
+  rb_hash_aset(result, ID2SYM(rb_intern("nodes")), ULONG2NUM(parser->nodes));
+  rb_hash_aset(result, ID2SYM(rb_intern("allocations")), SIZET2NUM(parser->allocations));
+  rb_hash_aset(result, ID2SYM(rb_intern("nanoseconds")), LL2NUM(parser->nanoseconds));
+  return result;
+}
+
+// Give the memory of the arena back and start the peak over
+VALUE gql_parser_reset(VALUE self)
+{
+  struct gql_parser *parser = gql_parser_get(self);
+  if (parser->parsing)
+    rb_raise(rb_eRuntimeError, "The parser can't be reset while parsing a document");
+
+  xfree(parser->arena.items);
+  MEMZERO(parser, struct gql_parser, 1);
+  return self;
+}
+
+// Just a helper to get the monotonic time in nanoseconds
+static long long gql_parser_clock(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
 /* ALL THE PARSERS METHODS FOR THE ABOVE STRUCTURES */
-// Parse an execution document
+// Parse an execution document using the parser of the current thread, or a
+// new one when it is already parsing, like from Ruby code called by the parse
 // EXECUTION DOCUMENT [OPERATION*, FRAGMENT*]
 VALUE gql_parse_execution(VALUE self, VALUE document)
+{
+  VALUE parser = gql_parser_current(GQLParserParser);
+  if (gql_parser_get(parser)->parsing)
+    parser = rb_class_new_instance(0, NULL, GQLParserParser);
+
+  return gql_parser_parse_execution(parser, document);
+}
+
+// Release the parser once the parse is done, even when it failed
+VALUE gql_parse_execution_done(VALUE ptr)
+{
+  ((struct gql_parser *)ptr)->parsing = 0;
+  return Qnil;
+}
+
+// Parse an execution document, collecting the stats into the parser. The
+// arena is used from the start, so the same parser can't parse two documents
+// at the same time
+// EXECUTION DOCUMENT [OPERATION*, FRAGMENT*]
+VALUE gql_parse_execution_with(struct gql_parser *parser, VALUE document)
 {
   if (!RB_TYPE_P(document, T_STRING))
     rb_raise(rb_eArgError, "%+" PRIsVALUE " is not a string", document);
 
-  // Initialize its pieces
+  if (parser->parsing)
+    rb_raise(rb_eRuntimeError, "The parser is already parsing a document");
+
+  VALUE args[] = {(VALUE)parser, document};
+  parser->parsing = 1;
+  return rb_ensure(gql_parse_execution_body, (VALUE)args, gql_parse_execution_done, (VALUE)parser);
+}
+
+// The parse itself, which receives the parser and the document
+// EXECUTION DOCUMENT [OPERATION*, FRAGMENT*]
+VALUE gql_parse_execution_body(VALUE args)
+{
+  struct gql_parser *parser = (struct gql_parser *)((VALUE *)args)[0];
+  VALUE document = ((VALUE *)args)[1];
+
+  // Save where the numbers start from
+  long long started_at = gql_parser_clock();
+  size_t allocated = rb_gc_stat(gql_total_allocated_objects);
+
+  // Initialize its pieces, dropping anything left behind by a failed parse
   VALUE pieces[] = {Qnil, Qnil};
   struct gql_scanner scanner = gql_new_scanner(document);
+  scanner.arena = &parser->arena;
+  parser->arena.size = 0;
   gql_next_lexeme_no_comments(&scanner);
 
   // Go over all the operations and fragments
@@ -99,7 +259,15 @@ VALUE gql_parse_execution(VALUE self, VALUE document)
   }
 
   // Return the plain array, no need to turn into a token
-  return rb_ary_new4(2, pieces);
+  VALUE result = rb_ary_new4(2, pieces);
+
+  // Save the numbers of the parse
+  parser->bytes = scanner.current_pos;
+  parser->tokens = scanner.tokens;
+  parser->nodes = scanner.nodes;
+  parser->allocations = rb_gc_stat(gql_total_allocated_objects) - allocated;
+  parser->nanoseconds = gql_parser_clock() - started_at;
+  return result;
 }
 
 // Parse an operation element
@@ -191,7 +359,7 @@ VALUE gql_parse_fragment(struct gql_scanner *scanner)
 VALUE gql_parse_variables(struct gql_scanner *scanner)
 {
   // The list can be nil if "()"
-  VALUE result = Qnil;
+  long mark = scanner->arena->size;
 
   // Skip the (
   GQL_SCAN_NEXT(scanner);
@@ -201,14 +369,17 @@ VALUE gql_parse_variables(struct gql_scanner *scanner)
   while (scanner->lexeme != gql_is_cl_paren)
   {
     if (GQL_SCAN_ERROR(scanner))
+    {
+      GQL_ARENA_RELEASE(scanner, mark);
       return gql_nil_and_unknown(scanner);
+    }
 
-    GQL_SAFE_PUSH(result, gql_parse_variable(scanner));
+    gql_arena_push(scanner->arena, gql_parse_variable(scanner));
   }
 
   // Just return the array filled with variables, no need to make it as a token
   GQL_SCAN_NEXT(scanner);
-  return result;
+  return GQL_ARENA_LIST(scanner, mark);
 }
 
 // VARIABLE [name, TYPE, value?, DIRECTIVE*]
@@ -269,14 +440,14 @@ VALUE gql_parse_variable(struct gql_scanner *scanner)
 VALUE gql_parse_directives(struct gql_scanner *scanner)
 {
   // Start the list of directives, we have at least one when it gets here
-  VALUE result = rb_ary_new();
+  long mark = scanner->arena->size;
 
   // Look for all the directives
   while (scanner->lexeme == gql_i_directive)
-    rb_ary_push(result, gql_parse_directive(scanner));
+    gql_arena_push(scanner->arena, gql_parse_directive(scanner));
 
   // Just return the array filled with variables, no need to make it as a token
-  return result;
+  return gql_arena_to_ary(scanner->arena, mark);
 }
 
 // DIRECTIVE [name, ARGUMENT*]
@@ -311,7 +482,7 @@ VALUE gql_parse_directive(struct gql_scanner *scanner)
 VALUE gql_parse_fields(struct gql_scanner *scanner)
 {
   // The list can be nil if "{}"
-  VALUE result = Qnil;
+  long mark = scanner->arena->size;
 
   // Skip the {
   GQL_SCAN_NEXT(scanner);
@@ -321,16 +492,19 @@ VALUE gql_parse_fields(struct gql_scanner *scanner)
   while (scanner->lexeme != gql_is_cl_curly)
   {
     if (GQL_SCAN_ERROR(scanner))
+    {
+      GQL_ARENA_RELEASE(scanner, mark);
       return gql_nil_and_unknown(scanner);
+    }
     else if (scanner->lexeme == gql_is_period)
-      GQL_SAFE_PUSH(result, gql_parse_spread(scanner));
+      gql_arena_push(scanner->arena, gql_parse_spread(scanner));
     else
-      GQL_SAFE_PUSH(result, gql_parse_field(scanner));
+      gql_arena_push(scanner->arena, gql_parse_field(scanner));
   }
 
   // Just return the array filled with fields, no need to make it as a token
   GQL_SCAN_NEXT(scanner);
-  return result;
+  return GQL_ARENA_LIST(scanner, mark);
 }
 
 // FIELD [name, alias?, ARGUMENT*, DIRECTIVE*, FIELD*]
@@ -389,7 +563,7 @@ VALUE gql_parse_field(struct gql_scanner *scanner)
 VALUE gql_parse_arguments(struct gql_scanner *scanner)
 {
   // The list can be nil if "()"
-  VALUE result = Qnil;
+  long mark = scanner->arena->size;
 
   // Skip the (
   GQL_SCAN_NEXT(scanner);
@@ -399,14 +573,17 @@ VALUE gql_parse_arguments(struct gql_scanner *scanner)
   while (scanner->lexeme != gql_is_cl_paren)
   {
     if (GQL_SCAN_ERROR(scanner))
+    {
+      GQL_ARENA_RELEASE(scanner, mark);
       return gql_nil_and_unknown(scanner);
+    }
 
-    GQL_SAFE_PUSH(result, gql_parse_argument(scanner));
+    gql_arena_push(scanner->arena, gql_parse_argument(scanner));
   }
 
   // Just return the array filled with arguments, no need to make it as a token
   GQL_SCAN_NEXT(scanner);
-  return result;
+  return GQL_ARENA_LIST(scanner, mark);
 }
 
 // ARGUMENT [name, value?, var_name?]
@@ -628,4 +805,20 @@ void Init_gql_parser()
   rb_define_attr(QLGParserToken, "type", 1, 0);
 
   gql_eParserError = rb_define_class_under(GQLParser, "ParserError", rb_eStandardError);
+
+  gql_total_allocated_objects = ID2SYM(rb_intern("total_allocated_objects"));
+
+  GQLParserParser = rb_define_class_under(GQLParser, "Parser", rb_cObject);
+  rb_define_alloc_func(GQLParserParser, gql_parser_alloc);
+  rb_define_singleton_method(GQLParserParser, "current", gql_parser_current, 0);
+  rb_define_method(GQLParserParser, "parse_execution", gql_parser_parse_execution, 1);
+  rb_define_method(GQLParserParser, "peak", gql_parser_peak, 0);
+  rb_define_method(GQLParserParser, "capacity", gql_parser_capacity, 0);
+  rb_define_method(GQLParserParser, "stats", gql_parser_stats, 0);
+  rb_define_method(GQLParserParser, "reset", gql_parser_reset, 0);
+
+  Init_gql_subscription_index();
+  Init_gql_variables();
+  Init_gql_scalars();
+  Init_gql_printer();
 }
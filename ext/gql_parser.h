@@ -1,5 +1,19 @@
 #include "ruby.h"
 
+// The state of a parser, which holds the arena that the lists are collected
+// on, so that the memory is kept between parses, and the stats of its last one.
+// A parser is not reentrant, so +parsing+ marks that its arena is in use
+struct gql_parser
+{
+  struct gql_arena arena;
+  int parsing;
+  unsigned long bytes;
+  unsigned long tokens;
+  unsigned long nodes;
+  size_t allocations;
+  long long nanoseconds;
+};
+
 #define GQL_SAFE_PUSH_AND_NEXT(source, scanner, action) ({ \
   GQL_SAFE_PUSH(source, action);                           \
   gql_next_lexeme_no_comments(scanner);                    \
@@ -19,3 +33,4 @@
 VALUE GQLParser;
 VALUE QLGParserToken;
 VALUE gql_eParserError;
+VALUE GQLParserParser;
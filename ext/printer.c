@@ -0,0 +1,378 @@
+#include "ruby.h"
+#include "ruby/encoding.h"
+#include "shared.h"
+
+// Pieces starting with one of these must be apart from the previous one when
+// it ends with one of them as well, like names and numbers
+#define GQL_PRINT_WORD(x) (GQL_S_CHARACTER(x) || GQL_S_DIGIT(x))
+#define GQL_PRINT_PUNCTUATOR(x) (x == '{' || x == '}' || x == '(' || x == ')' || x == '[' || x == ']' || \
+  x == ':' || x == '=' || x == '@' || x == '$' || x == '!' || x == '|' || x == '&')
+
+#define GQL_PRINT_STR(output, value) (gql_print_append(output, value, sizeof(value) - 1))
+
+/* HELPERS */
+
+// Add a piece to the output, with a space only when it would be read together
+// with the previous one
+void gql_print_append(VALUE output, const char *piece, long size)
+{
+  long length = RSTRING_LEN(output);
+  if (size == 0)
+    return;
+
+  char last = length > 0 ? RSTRING_PTR(output)[length - 1] : '\0';
+  if (GQL_PRINT_WORD(last) && (GQL_PRINT_WORD(*piece) || *piece == '.'))
+    rb_str_buf_cat(output, " ", 1);
+
+  rb_str_buf_cat(output, piece, size);
+}
+
+// Same as the above, but from a Ruby string or token
+void gql_print_append_value(VALUE output, VALUE value)
+{
+  value = rb_obj_as_string(value);
+  gql_print_append(output, RSTRING_PTR(value), RSTRING_LEN(value));
+}
+
+// Get the list behind a token of the parse tree
+VALUE gql_print_items(VALUE token)
+{
+  return NIL_P(token) ? Qnil : rb_check_array_type(token);
+}
+
+// Get one of the pieces of a token of the parse tree
+VALUE gql_print_item(VALUE token, long index)
+{
+  VALUE items = gql_print_items(token);
+  if (NIL_P(items))
+    rb_raise(rb_eArgError, "%+" PRIsVALUE " is not a valid parse tree node", token);
+
+  return rb_ary_entry(items, index);
+}
+
+/* MINIFY */
+
+// Go over the whole source writing only the tokens that matter to the output,
+// which drops comments, commas, and any other ignorable characters. Hash
+// literals are written exactly as they are in the source
+void gql_minify_into(VALUE output, VALUE source)
+{
+  struct gql_scanner instance = gql_new_scanner(source);
+  struct gql_scanner *scanner = &instance;
+  enum gql_lexeme lexeme;
+  char previous = '\0';
+  long lists = 0;
+
+  while (1)
+  {
+    // Skip everything that can be ignored and mark where the token starts
+    GQL_SCAN_WHILE(scanner, GQL_S_IGNORE(scanner->current));
+    scanner->start_pos = scanner->current_pos;
+    scanner->begin_line = scanner->current_line;
+    scanner->begin_column = scanner->current_pos - scanner->last_ln_at;
+
+    if (scanner->current == '\0')
+      break;
+    else if (scanner->current == '#')
+    {
+      GQL_SCAN_WHILE(scanner, scanner->current != '\n' && scanner->current != '\0');
+      continue;
+    }
+    else if (GQL_S_CHARACTER(scanner->current))
+      lexeme = gql_read_name(scanner);
+    else if (GQL_S_DIGIT(scanner->current) || (scanner->current == '-' && GQL_S_DIGIT(GQL_SCAN_LOOK(scanner, 1))))
+    {
+      lexeme = gql_read_number(scanner);
+
+      // The scanner does not move past a zero, which can still have a fraction
+      if (lexeme == gql_iv_integer && scanner->current == '0')
+      {
+        GQL_SCAN_NEXT(scanner);
+        if (GQL_S_FLOAT_MARK(scanner->current))
+          lexeme = gql_read_float(scanner);
+      }
+    }
+    else if (scanner->current == '"')
+      lexeme = gql_read_string(scanner, 1);
+    else if (scanner->current == '.' && GQL_SCAN_LOOK(scanner, 1) == '.' && GQL_SCAN_LOOK(scanner, 2) == '.')
+    {
+      scanner->current_pos += 3;
+      scanner->current = GQL_SCAN_CHAR(scanner);
+      lexeme = gql_is_period;
+    }
+    // Selection sets never come after these nor inside lists, so it can only
+    // be a hash literal
+    else if (scanner->current == '{' && (lists > 0 || previous == ':' || previous == '='))
+      lexeme = gql_read_hash(scanner);
+    else if (GQL_PRINT_PUNCTUATOR(scanner->current))
+    {
+      if (scanner->current == '[')
+        lists++;
+      else if (scanner->current == ']' && lists > 0)
+        lists--;
+
+      GQL_SCAN_NEXT(scanner);
+      lexeme = gql_is_period;
+    }
+    else
+      lexeme = gql_i_unknown;
+
+    if (lexeme == gql_i_unknown)
+      gql_throw_parser_error(scanner);
+
+    gql_print_append(output, scanner->doc + scanner->start_pos, GQL_SCAN_SIZE(scanner));
+    previous = scanner->doc[scanner->current_pos - 1];
+  }
+}
+
+// Return the given document without anything that is ignorable, and with the
+// least amount of spaces necessary to keep it the same document
+VALUE gql_minify(VALUE self, VALUE document)
+{
+  if (!RB_TYPE_P(document, T_STRING))
+    rb_raise(rb_eArgError, "%+" PRIsVALUE " is not a string", document);
+
+  VALUE result = rb_str_buf_new(RSTRING_LEN(document));
+  gql_minify_into(result, document);
+  rb_enc_copy(result, document);
+  return result;
+}
+
+/* PRINTER */
+
+// VALUE, which holds the source of it, besides null and booleans
+void gql_print_value(VALUE output, VALUE value)
+{
+  if (RTEST(rb_obj_is_kind_of(value, QLGParserToken)))
+  {
+    // The contents of hash literals are kept as they are
+    if (RTEST(gql_token_of_type_check(value, ID2SYM(rb_intern("hash")))))
+      return gql_print_append_value(output, value);
+
+    value = rb_funcall(value, rb_intern("__getobj__"), 0);
+  }
+
+  if (NIL_P(value))
+    GQL_PRINT_STR(output, "null");
+  else if (value == Qtrue)
+    GQL_PRINT_STR(output, "true");
+  else if (value == Qfalse)
+    GQL_PRINT_STR(output, "false");
+  else
+    gql_minify_into(output, rb_obj_as_string(value));
+}
+
+// TYPE [name, dimensions, nullability]
+void gql_print_type(VALUE output, VALUE type)
+{
+  long dimensions = NUM2LONG(gql_print_item(type, 1));
+  long nullability = NUM2LONG(gql_print_item(type, 2));
+
+  for (long i = 0; i < dimensions; i++)
+    GQL_PRINT_STR(output, "[");
+
+  gql_print_append_value(output, gql_print_item(type, 0));
+  if (nullability & (1L << dimensions))
+    GQL_PRINT_STR(output, "!");
+
+  for (long i = dimensions - 1; i >= 0; i--)
+  {
+    GQL_PRINT_STR(output, "]");
+    if (nullability & (1L << i))
+      GQL_PRINT_STR(output, "!");
+  }
+}
+
+// ARGUMENT [name, value?, var_name?]*
+void gql_print_arguments(VALUE output, VALUE list)
+{
+  VALUE items = gql_print_items(list);
+  if (NIL_P(items) || RARRAY_LEN(items) == 0)
+    return;
+
+  GQL_PRINT_STR(output, "(");
+  for (long i = 0; i < RARRAY_LEN(items); i++)
+  {
+    VALUE argument = RARRAY_AREF(items, i);
+    VALUE variable = gql_print_item(argument, 2);
+
+    gql_print_append_value(output, gql_print_item(argument, 0));
+    GQL_PRINT_STR(output, ":");
+
+    if (NIL_P(variable))
+      gql_print_value(output, gql_print_item(argument, 1));
+    else
+    {
+      GQL_PRINT_STR(output, "$");
+      gql_print_append_value(output, variable);
+    }
+  }
+
+  GQL_PRINT_STR(output, ")");
+}
+
+// DIRECTIVE [name, ARGUMENT*]*
+void gql_print_directives(VALUE output, VALUE list)
+{
+  VALUE items = gql_print_items(list);
+  if (NIL_P(items))
+    return;
+
+  for (long i = 0; i < RARRAY_LEN(items); i++)
+  {
+    VALUE directive = RARRAY_AREF(items, i);
+    GQL_PRINT_STR(output, "@");
+    gql_print_append_value(output, gql_print_item(directive, 0));
+    gql_print_arguments(output, gql_print_item(directive, 1));
+  }
+}
+
+// VARIABLE [name, TYPE, value?, DIRECTIVE*]*
+void gql_print_variables(VALUE output, VALUE list)
+{
+  VALUE items = gql_print_items(list);
+  if (NIL_P(items) || RARRAY_LEN(items) == 0)
+    return;
+
+  GQL_PRINT_STR(output, "(");
+  for (long i = 0; i < RARRAY_LEN(items); i++)
+  {
+    VALUE variable = RARRAY_AREF(items, i);
+    VALUE value = gql_print_item(variable, 2);
+
+    GQL_PRINT_STR(output, "$");
+    gql_print_append_value(output, gql_print_item(variable, 0));
+    GQL_PRINT_STR(output, ":");
+    gql_print_type(output, gql_print_item(variable, 1));
+
+    if (!NIL_P(value))
+    {
+      GQL_PRINT_STR(output, "=");
+      gql_print_value(output, value);
+    }
+
+    gql_print_directives(output, gql_print_item(variable, 3));
+  }
+
+  GQL_PRINT_STR(output, ")");
+}
+
+// FIELD [name, alias?, ARGUMENT*, DIRECTIVE*, FIELD*]*
+// SPREAD [name?, type?, DIRECTIVE*, FIELD*]
+void gql_print_fields(VALUE output, VALUE list)
+{
+  VALUE items = gql_print_items(list);
+  if (NIL_P(items))
+    return;
+
+  GQL_PRINT_STR(output, "{");
+  for (long i = 0; i < RARRAY_LEN(items); i++)
+  {
+    VALUE item = RARRAY_AREF(items, i);
+    if (RTEST(gql_token_of_type_check(item, ID2SYM(rb_intern("spread")))))
+    {
+      VALUE name = gql_print_item(item, 0);
+      VALUE type = gql_print_item(item, 1);
+
+      GQL_PRINT_STR(output, "...");
+      if (!NIL_P(name))
+        gql_print_append_value(output, name);
+      else if (!NIL_P(type))
+      {
+        GQL_PRINT_STR(output, "on");
+        gql_print_append_value(output, type);
+      }
+
+      gql_print_directives(output, gql_print_item(item, 2));
+      gql_print_fields(output, gql_print_item(item, 3));
+    }
+    else
+    {
+      VALUE alias = gql_print_item(item, 1);
+      if (!NIL_P(alias))
+      {
+        gql_print_append_value(output, alias);
+        GQL_PRINT_STR(output, ":");
+      }
+
+      gql_print_append_value(output, gql_print_item(item, 0));
+      gql_print_arguments(output, gql_print_item(item, 2));
+      gql_print_directives(output, gql_print_item(item, 3));
+      gql_print_fields(output, gql_print_item(item, 4));
+    }
+  }
+
+  GQL_PRINT_STR(output, "}");
+}
+
+// OPERATION [type?, name?, VARIABLE*, DIRECTIVE*, FIELD*]
+void gql_print_operation(VALUE output, VALUE operation)
+{
+  VALUE type = gql_print_item(operation, 0);
+
+  if (!NIL_P(type))
+  {
+    gql_print_append_value(output, type);
+    gql_print_append_value(output, gql_print_item(operation, 1));
+    gql_print_variables(output, gql_print_item(operation, 2));
+    gql_print_directives(output, gql_print_item(operation, 3));
+  }
+
+  gql_print_fields(output, gql_print_item(operation, 4));
+}
+
+// FRAGMENT [name, type, DIRECTIVE*, FIELD*]
+void gql_print_fragment(VALUE output, VALUE fragment)
+{
+  GQL_PRINT_STR(output, "fragment");
+  gql_print_append_value(output, gql_print_item(fragment, 0));
+  GQL_PRINT_STR(output, "on");
+  gql_print_append_value(output, gql_print_item(fragment, 1));
+  gql_print_directives(output, gql_print_item(fragment, 2));
+  gql_print_fields(output, gql_print_item(fragment, 3));
+}
+
+// Check if the first definition comes before the second one in the document,
+// using the location of their tokens
+int gql_print_comes_first(VALUE first, VALUE second)
+{
+  VALUE first_line = rb_iv_get(first, "@begin_line");
+  VALUE second_line = rb_iv_get(second, "@begin_line");
+  if (NIL_P(first_line) || NIL_P(second_line))
+    return 1;
+
+  if (NUM2ULONG(first_line) != NUM2ULONG(second_line))
+    return NUM2ULONG(first_line) < NUM2ULONG(second_line);
+
+  return NUM2ULONG(rb_iv_get(first, "@begin_column")) < NUM2ULONG(rb_iv_get(second, "@begin_column"));
+}
+
+// Print a parsed execution document back as a minified GraphQL document,
+// which is the canonical form of it, keeping the order of the definitions
+// EXECUTION DOCUMENT [OPERATION*, FRAGMENT*]
+VALUE gql_print_execution(VALUE self, VALUE document)
+{
+  VALUE result = rb_enc_associate(rb_str_buf_new(0), rb_utf8_encoding());
+  VALUE operations = gql_print_items(gql_print_item(document, 0));
+  VALUE fragments = gql_print_items(gql_print_item(document, 1));
+  long operations_size = NIL_P(operations) ? 0 : RARRAY_LEN(operations);
+  long fragments_size = NIL_P(fragments) ? 0 : RARRAY_LEN(fragments);
+  long i = 0, j = 0;
+
+  while (i < operations_size || j < fragments_size)
+  {
+    if (j >= fragments_size ||
+      (i < operations_size && gql_print_comes_first(RARRAY_AREF(operations, i), RARRAY_AREF(fragments, j))))
+      gql_print_operation(result, RARRAY_AREF(operations, i++));
+    else
+      gql_print_fragment(result, RARRAY_AREF(fragments, j++));
+  }
+
+  return result;
+}
+
+void Init_gql_printer(void)
+{
+  rb_define_singleton_method(GQLParser, "minify", gql_minify, 1);
+  rb_define_singleton_method(GQLParser, "print_execution", gql_print_execution, 1);
+}
@@ -0,0 +1,329 @@
+#include <limits.h>
+#include <time.h>
+#include "ruby.h"
+#include "shared.h"
+
+// The offsets that +rb_time_timespec_new+ uses for local and UTC times
+#define GQL_TIME_LOCAL INT_MAX
+#define GQL_TIME_UTC (INT_MAX - 1)
+
+#define GQL_ISO_SPACE(x) (x == ' ' || x == '\t' || x == '\n' || x == '\r' || x == '\f' || x == '\v')
+
+static const char gql_base64_alphabet[] =
+  "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// The reverse of the alphabet, where -1 means that the char is ignored
+static signed char gql_base64_table[256];
+
+/* HELPERS */
+
+// Days since 1970-01-01 of a given civil date, which also works for days and
+// months out of their range, the same way Ruby normalizes them
+long long gql_days_from_civil(long long year, long month, long day)
+{
+  year -= month <= 2;
+  long long era = (year >= 0 ? year : year - 399) / 400;
+  long long yoe = year - era * 400;
+  long long doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  long long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
+}
+
+// The civil date of a given number of days since 1970-01-01
+void gql_civil_from_days(long long days, long long *year, long *month, long *day)
+{
+  days += 719468;
+  long long era = (days >= 0 ? days : days - 146096) / 146097;
+  long long doe = days - era * 146097;
+  long long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  long long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  long long mp = (5 * doy + 2) / 153;
+
+  *day = (long)(doy - (153 * mp + 2) / 5 + 1);
+  *month = (long)(mp < 10 ? mp + 3 : mp - 9);
+  *year = yoe + era * 400 + (*month <= 2);
+}
+
+// Read exactly +size+ digits into +result+
+int gql_iso_digits(const char **cursor, const char *end, int size, long *result)
+{
+  *result = 0;
+  for (int i = 0; i < size; i++, (*cursor)++)
+  {
+    if (*cursor >= end || !GQL_S_DIGIT(**cursor))
+      return 0;
+
+    *result = *result * 10 + (**cursor - '0');
+  }
+
+  return 1;
+}
+
+/* ISO 8601 */
+
+// Parse a date time string, with the same format accepted by +Time.iso8601+,
+// returning nil when it is not valid. Fractions are kept up to nanoseconds
+VALUE gql_parse_iso8601(VALUE self, VALUE source)
+{
+  if (!RB_TYPE_P(source, T_STRING))
+    return Qnil;
+
+  const char *cursor = RSTRING_PTR(source);
+  const char *end = cursor + RSTRING_LEN(source);
+  long year_digits = 0, month, day, hour, minute, second, nsec = 0;
+  long long year = 0;
+  int negative = 0, offset = GQL_TIME_LOCAL;
+
+  while (cursor < end && GQL_ISO_SPACE(*cursor))
+    cursor++;
+
+  while (end > cursor && GQL_ISO_SPACE(*(end - 1)))
+    end--;
+
+  // The year can have any number of digits
+  if (cursor < end && *cursor == '-')
+  {
+    negative = 1;
+    cursor++;
+  }
+
+  while (cursor < end && GQL_S_DIGIT(*cursor))
+  {
+    if (++year_digits > 9)
+      return Qnil;
+
+    year = year * 10 + (*cursor++ - '0');
+  }
+
+  if (year_digits == 0)
+    return Qnil;
+
+  if (negative)
+    year = -year;
+
+  // Then the rest of the date and the time
+  if (cursor >= end || *cursor++ != '-' || !gql_iso_digits(&cursor, end, 2, &month))
+    return Qnil;
+
+  if (cursor >= end || *cursor++ != '-' || !gql_iso_digits(&cursor, end, 2, &day))
+    return Qnil;
+
+  if (cursor >= end || (*cursor != 'T' && *cursor != 't'))
+    return Qnil;
+
+  cursor++;
+  if (!gql_iso_digits(&cursor, end, 2, &hour) || cursor >= end || *cursor++ != ':')
+    return Qnil;
+
+  if (!gql_iso_digits(&cursor, end, 2, &minute) || cursor >= end || *cursor++ != ':')
+    return Qnil;
+
+  if (!gql_iso_digits(&cursor, end, 2, &second))
+    return Qnil;
+
+  // The fraction, truncated to nanoseconds
+  if (cursor < end && *cursor == '.')
+  {
+    int digits = 0;
+    if (++cursor >= end || !GQL_S_DIGIT(*cursor))
+      return Qnil;
+
+    while (cursor < end && GQL_S_DIGIT(*cursor))
+    {
+      if (digits++ < 9)
+        nsec = nsec * 10 + (*cursor - '0');
+
+      cursor++;
+    }
+
+    for (; digits < 9; digits++)
+      nsec *= 10;
+  }
+
+  // The zone, where -00:00 also means UTC
+  if (cursor < end && (*cursor == 'Z' || *cursor == 'z'))
+  {
+    offset = GQL_TIME_UTC;
+    cursor++;
+  }
+  else if (cursor < end && (*cursor == '+' || *cursor == '-'))
+  {
+    long zone_hour, zone_minute = 0;
+    int sign = *cursor++ == '-' ? -1 : 1;
+
+    if (!gql_iso_digits(&cursor, end, 2, &zone_hour))
+      return Qnil;
+
+    if (cursor < end)
+    {
+      if (*cursor == ':')
+        cursor++;
+
+      if (!gql_iso_digits(&cursor, end, 2, &zone_minute))
+        return Qnil;
+    }
+
+    // Same range accepted by Time as an offset
+    if (zone_hour > 23 || zone_minute > 59)
+      return Qnil;
+
+    offset = sign * (int)(zone_hour * 3600 + zone_minute * 60);
+    if (offset == 0 && sign < 0)
+      offset = GQL_TIME_UTC;
+  }
+
+  if (cursor != end)
+    return Qnil;
+
+  // Same ranges accepted by Time.utc
+  if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 24 || minute > 59 || second > 60)
+    return Qnil;
+
+  // Without a zone, the system one is used
+  if (offset == GQL_TIME_LOCAL)
+  {
+    VALUE args[] = {
+      LL2NUM(year), LONG2NUM(month), LONG2NUM(day), LONG2NUM(hour),
+      LONG2NUM(minute), LONG2NUM(second), rb_rational_new(LONG2NUM(nsec), LONG2NUM(1000)),
+    };
+
+    return rb_funcallv(rb_cTime, rb_intern("local"), 7, args);
+  }
+
+  struct timespec ts;
+  long long seconds = gql_days_from_civil(year, month, day) * 86400LL;
+  seconds += hour * 3600 + minute * 60 + second;
+  ts.tv_sec = (time_t)(seconds - (offset == GQL_TIME_UTC ? 0 : offset));
+  ts.tv_nsec = nsec;
+  return rb_time_timespec_new(&ts, offset);
+}
+
+// Format a time the same way as +Time#iso8601+, returning nil when it can
+// not be done natively
+VALUE gql_format_iso8601(VALUE self, VALUE time)
+{
+  if (!rb_obj_is_kind_of(time, rb_cTime))
+    return Qnil;
+
+  int utc = RTEST(rb_funcall(time, rb_intern("utc?"), 0));
+  long offset = utc ? 0 : NUM2LONG(rb_time_utc_offset(time));
+  if (offset % 60 != 0)
+    return Qnil;
+
+  struct timespec ts = rb_time_timespec(time);
+  long long seconds = (long long)ts.tv_sec + offset;
+  long long days = seconds >= 0 ? seconds / 86400 : (seconds - 86399) / 86400;
+  long long rest = seconds - days * 86400;
+
+  long long year;
+  long month, day;
+  gql_civil_from_days(days, &year, &month, &day);
+  if (year < 0 || year > 9999)
+    return Qnil;
+
+  char buffer[32];
+  int size = snprintf(buffer, sizeof(buffer), "%04lld-%02ld-%02ldT%02lld:%02lld:%02lld",
+    year, month, day, rest / 3600, (rest / 60) % 60, rest % 60);
+
+  if (utc)
+    buffer[size++] = 'Z';
+  else
+  {
+    long absolute = offset < 0 ? -offset : offset;
+    size += snprintf(buffer + size, sizeof(buffer) - size, "%c%02ld:%02ld",
+      offset < 0 ? '-' : '+', absolute / 3600, (absolute / 60) % 60);
+  }
+
+  return rb_usascii_str_new(buffer, size);
+}
+
+/* BASE 64 */
+
+// Encode a string into Base64, without any line feeds
+VALUE gql_encode64(VALUE self, VALUE source)
+{
+  StringValue(source);
+
+  const unsigned char *input = (const unsigned char *)RSTRING_PTR(source);
+  long size = RSTRING_LEN(source);
+  VALUE result = rb_usascii_str_new(NULL, ((size + 2) / 3) * 4);
+  char *output = RSTRING_PTR(result);
+  long i = 0;
+
+  for (; i + 2 < size; i += 3)
+  {
+    unsigned long chunk = (input[i] << 16) | (input[i + 1] << 8) | input[i + 2];
+    *output++ = gql_base64_alphabet[(chunk >> 18) & 0x3f];
+    *output++ = gql_base64_alphabet[(chunk >> 12) & 0x3f];
+    *output++ = gql_base64_alphabet[(chunk >> 6) & 0x3f];
+    *output++ = gql_base64_alphabet[chunk & 0x3f];
+  }
+
+  if (i < size)
+  {
+    unsigned long chunk = input[i] << 16;
+    if (i + 1 < size)
+      chunk |= input[i + 1] << 8;
+
+    *output++ = gql_base64_alphabet[(chunk >> 18) & 0x3f];
+    *output++ = gql_base64_alphabet[(chunk >> 12) & 0x3f];
+    *output++ = i + 1 < size ? gql_base64_alphabet[(chunk >> 6) & 0x3f] : '=';
+    *output++ = '=';
+  }
+
+  return result;
+}
+
+// Decode a Base64 string, ignoring any character outside of the alphabet,
+// like line feeds, the same way as +Base64.decode64+
+VALUE gql_decode64(VALUE self, VALUE source)
+{
+  StringValue(source);
+
+  const unsigned char *input = (const unsigned char *)RSTRING_PTR(source);
+  long size = RSTRING_LEN(source);
+  VALUE result = rb_str_new(NULL, (size / 4) * 3 + 3);
+  unsigned char *output = (unsigned char *)RSTRING_PTR(result);
+  unsigned long chunk = 0;
+  int count = 0;
+  long written = 0;
+
+  for (long i = 0; i < size && input[i] != '='; i++)
+  {
+    signed char value = gql_base64_table[input[i]];
+    if (value < 0)
+      continue;
+
+    chunk = (chunk << 6) | value;
+    if (++count == 4)
+    {
+      output[written++] = (chunk >> 16) & 0xff;
+      output[written++] = (chunk >> 8) & 0xff;
+      output[written++] = chunk & 0xff;
+      chunk = count = 0;
+    }
+  }
+
+  if (count == 3)
+  {
+    output[written++] = (chunk >> 10) & 0xff;
+    output[written++] = (chunk >> 2) & 0xff;
+  }
+  else if (count == 2)
+    output[written++] = (chunk >> 4) & 0xff;
+
+  rb_str_set_len(result, written);
+  return result;
+}
+
+void Init_gql_scalars(void)
+{
+  memset(gql_base64_table, -1, sizeof(gql_base64_table));
+  for (int i = 0; i < 64; i++)
+    gql_base64_table[(unsigned char)gql_base64_alphabet[i]] = i;
+
+  rb_define_singleton_method(GQLParser, "parse_iso8601", gql_parse_iso8601, 1);
+  rb_define_singleton_method(GQLParser, "format_iso8601", gql_format_iso8601, 1);
+  rb_define_singleton_method(GQLParser, "encode64", gql_encode64, 1);
+  rb_define_singleton_method(GQLParser, "decode64", gql_decode64, 1);
+}
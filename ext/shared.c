@@ -51,6 +51,30 @@ struct gql_scanner gql_new_scanner(VALUE source)
   return scanner;
 }
 
+// Add a value to the arena, growing it when needed
+void gql_arena_push(struct gql_arena *arena, VALUE value)
+{
+  if (arena->size == arena->capa)
+  {
+    long capa = arena->capa == 0 ? 64 : arena->capa * 2;
+    REALLOC_N(arena->items, VALUE, capa);
+    arena->capa = capa;
+  }
+
+  arena->items[arena->size++] = value;
+  if (arena->size > arena->peak)
+    arena->peak = arena->size;
+}
+
+// Turn everything added to the arena since +mark+ into an exactly sized array
+// and give that space back to the arena
+VALUE gql_arena_to_ary(struct gql_arena *arena, long mark)
+{
+  VALUE result = rb_ary_new_from_values(arena->size - mark, arena->items + mark);
+  arena->size = mark;
+  return result;
+}
+
 // Returns the base index of the lexeme from where the upgrade should move from
 enum gql_lexeme gql_upgrade_basis(const char *upgrade_from[])
 {
@@ -250,6 +274,7 @@ void gql_next_lexeme(struct gql_scanner *scanner)
   GQL_SCAN_WHILE(scanner, GQL_S_IGNORE(scanner->current));
 
   // Mark where the new interesting thing has started
+  scanner->tokens++;
   scanner->start_pos = scanner->current_pos;
   scanner->begin_line = scanner->current_line;
   scanner->begin_column = scanner->current_pos - scanner->last_ln_at;
@@ -330,6 +355,7 @@ VALUE gql_as_token(VALUE self, struct gql_scanner *scanner, int save_type)
 {
   // Initialize the instance
   VALUE instance = rb_class_new_instance(1, &self, QLGParserToken);
+  scanner->nodes++;
 
   // Add the location instance variables
   int offset = scanner->begin_line == 1 ? 1 : 0;
@@ -384,8 +410,8 @@ VALUE gql_scanner_to_token(struct gql_scanner *scanner)
 // Goes over an array and grab all the elements
 VALUE gql_array_to_rb(struct gql_scanner *scanner)
 {
-  // Start the array and the temporary element
-  VALUE result = rb_ary_new();
+  // Mark where the elements start in the arena and the temporary element
+  long mark = scanner->arena->size;
   VALUE element;
 
   // Save the scan and grab the next char
@@ -397,6 +423,7 @@ VALUE gql_array_to_rb(struct gql_scanner *scanner)
     // If we got to the end of the file and the array was not closed, then we have something wrong
     if (scanner->current == '\0')
     {
+      GQL_ARENA_RELEASE(scanner, mark);
       scanner->lexeme = gql_i_unknown;
       return Qnil;
     }
@@ -406,15 +433,19 @@ VALUE gql_array_to_rb(struct gql_scanner *scanner)
 
     // If it found an unknown, then we bubble the problem up
     if (scanner->lexeme == gql_i_unknown)
+    {
+      GQL_ARENA_RELEASE(scanner, mark);
       return Qnil;
+    }
 
     // Add the value to the array and scan through everything ignorable
-    rb_ary_push(result, element);
+    gql_arena_push(scanner->arena, element);
     GQL_SCAN_WHILE(scanner, GQL_S_IGNORE(scanner->current));
   }
 
   // Save where the array has actually ended, change the lexeme and return
   GQL_SCAN_SET_END(scanner, 0);
+  VALUE result = gql_arena_to_ary(scanner->arena, mark);
   scanner->lexeme = gql_iv_array;
   return result;
 }
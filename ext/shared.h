@@ -70,6 +70,13 @@
   rb_ary_push(source, value);           \
 })
 
+#define GQL_ARENA_LIST(scanner, mark) ({                                       \
+  scanner->arena->size > mark ? gql_arena_to_ary(scanner->arena, mark) : Qnil; \
+})
+#define GQL_ARENA_RELEASE(scanner, mark) ({ \
+  scanner->arena->size = mark;             \
+})
+
 #define GQL_SAFE_NAME_TO_KEYWORD(scanner, source) ({                        \
   gql_name_to_keyword(scanner, source, (sizeof(source) / sizeof(char *))); \
 })
@@ -130,6 +137,16 @@ enum gql_lexeme
   gql_i_unknown          = 0xff
 };
 
+// The scratch memory where the items of the lists being parsed are collected
+// before becoming exactly sized arrays, which is reused across parses
+struct gql_arena
+{
+  VALUE *items;
+  long size;
+  long capa;
+  long peak;
+};
+
 struct gql_scanner
 {
   unsigned long start_pos;
@@ -143,6 +160,9 @@ struct gql_scanner
   char *doc;
   char current;
   enum gql_lexeme lexeme;
+  struct gql_arena *arena;
+  unsigned long tokens;
+  unsigned long nodes;
 };
 
 extern VALUE GQLParser;
@@ -156,6 +176,11 @@ extern const char *GQL_DEFINITION_KEYWORDS[12];
 void gql_debug_print(const char *message);
 struct gql_scanner gql_new_scanner(VALUE source);
 
+void gql_arena_push(struct gql_arena *arena, VALUE value);
+VALUE gql_arena_to_ary(struct gql_arena *arena, long mark);
+
+NORETURN(void gql_throw_parser_error(struct gql_scanner *scanner));
+
 enum gql_lexeme gql_upgrade_basis(const char *upgrade_from[]);
 enum gql_lexeme gql_name_to_keyword(struct gql_scanner *scanner, const char *keywords[], unsigned int size);
 
@@ -179,3 +204,8 @@ VALUE gql_scanner_to_token(struct gql_scanner *scanner);
 VALUE gql_array_to_rb(struct gql_scanner *scanner);
 VALUE gql_value_to_rb(struct gql_scanner *scanner, int accept_var);
 VALUE gql_value_to_token(struct gql_scanner *scanner, int accept_var);
+
+void Init_gql_subscription_index(void);
+void Init_gql_variables(void);
+void Init_gql_scalars(void);
+void Init_gql_printer(void);
@@ -0,0 +1,382 @@
+#include "ruby.h"
+#include "ruby/st.h"
+#include "shared.h"
+
+// The key used when there is no scope or arguments
+#define GQL_INDEX_EMPTY_KEY ((st_data_t)0)
+
+// Get the key from a Ruby value, where nil represents empty
+#define GQL_INDEX_KEY(value) (NIL_P(value) ? GQL_INDEX_EMPTY_KEY : (st_data_t)NUM2ULL(value))
+
+// Get the bucket or the next table from a given table and a given key
+#define GQL_INDEX_LOOKUP(table, key, result) (st_lookup(table, key, (st_data_t *)&result))
+
+VALUE gql_cSubscriptionIndex;
+
+// A list of slots, where removing happens by moving the last item in place of
+// the removed one, so there are no tombstones
+struct gql_index_bucket
+{
+  long size;
+  long capa;
+  long *slots;
+};
+
+// Each subscription occupies one slot, which holds the path in the index and
+// its position in the bucket. Free slots are chained using +position+
+struct gql_index_entry
+{
+  VALUE sid;
+  st_data_t field;
+  st_data_t scope;
+  st_data_t args;
+  long position;
+};
+
+// The index itself, which is a 3-level table of field -> scope -> args that
+// ends up in buckets of slots
+struct gql_index
+{
+  st_table *fields;
+  struct gql_index_entry *entries;
+  long entries_capa;
+  long entries_size;
+  long free_slot;
+  long size;
+};
+
+/* MEMORY MANAGEMENT */
+
+void gql_index_mark(void *ptr)
+{
+  struct gql_index *index = ptr;
+  for (long i = 0; i < index->entries_size; i++)
+    rb_gc_mark(index->entries[i].sid);
+}
+
+int gql_index_free_bucket(st_data_t key, st_data_t value, st_data_t arg)
+{
+  struct gql_index_bucket *bucket = (struct gql_index_bucket *)value;
+  xfree(bucket->slots);
+  xfree(bucket);
+  return ST_CONTINUE;
+}
+
+int gql_index_free_args(st_data_t key, st_data_t value, st_data_t arg)
+{
+  st_foreach((st_table *)value, gql_index_free_bucket, 0);
+  st_free_table((st_table *)value);
+  return ST_CONTINUE;
+}
+
+int gql_index_free_scopes(st_data_t key, st_data_t value, st_data_t arg)
+{
+  st_foreach((st_table *)value, gql_index_free_args, 0);
+  st_free_table((st_table *)value);
+  return ST_CONTINUE;
+}
+
+void gql_index_free(void *ptr)
+{
+  struct gql_index *index = ptr;
+  st_foreach(index->fields, gql_index_free_scopes, 0);
+  st_free_table(index->fields);
+  xfree(index->entries);
+  xfree(index);
+}
+
+int gql_index_size_bucket(st_data_t key, st_data_t value, st_data_t arg)
+{
+  struct gql_index_bucket *bucket = (struct gql_index_bucket *)value;
+  *(size_t *)arg += sizeof(struct gql_index_bucket) + bucket->capa * sizeof(long);
+  return ST_CONTINUE;
+}
+
+int gql_index_size_args(st_data_t key, st_data_t value, st_data_t arg)
+{
+  *(size_t *)arg += st_memsize((st_table *)value);
+  st_foreach((st_table *)value, gql_index_size_bucket, arg);
+  return ST_CONTINUE;
+}
+
+int gql_index_size_scopes(st_data_t key, st_data_t value, st_data_t arg)
+{
+  *(size_t *)arg += st_memsize((st_table *)value);
+  st_foreach((st_table *)value, gql_index_size_args, arg);
+  return ST_CONTINUE;
+}
+
+size_t gql_index_memsize(const void *ptr)
+{
+  const struct gql_index *index = ptr;
+  size_t result = sizeof(struct gql_index) + st_memsize(index->fields);
+  result += index->entries_capa * sizeof(struct gql_index_entry);
+  st_foreach(index->fields, gql_index_size_scopes, (st_data_t)&result);
+  return result;
+}
+
+static const rb_data_type_t gql_index_type = {
+  "GQLParser::SubscriptionIndex",
+  {gql_index_mark, gql_index_free, gql_index_memsize},
+  0, 0, RUBY_TYPED_FREE_IMMEDIATELY
+};
+
+VALUE gql_index_alloc(VALUE klass)
+{
+  struct gql_index *index;
+  VALUE result = TypedData_Make_Struct(klass, struct gql_index, &gql_index_type, index);
+
+  index->fields = st_init_numtable();
+  index->entries = NULL;
+  index->entries_capa = 0;
+  index->entries_size = 0;
+  index->free_slot = -1;
+  index->size = 0;
+
+  return result;
+}
+
+struct gql_index *gql_index_get(VALUE self)
+{
+  struct gql_index *index;
+  TypedData_Get_Struct(self, struct gql_index, &gql_index_type, index);
+  return index;
+}
+
+/* HELPERS */
+
+// Find or create the bucket for the given path
+struct gql_index_bucket *gql_index_bucket_for(struct gql_index *index, st_data_t field, st_data_t scope, st_data_t args)
+{
+  st_table *scopes, *arguments;
+  struct gql_index_bucket *bucket;
+
+  if (!GQL_INDEX_LOOKUP(index->fields, field, scopes))
+  {
+    scopes = st_init_numtable();
+    st_insert(index->fields, field, (st_data_t)scopes);
+  }
+
+  if (!GQL_INDEX_LOOKUP(scopes, scope, arguments))
+  {
+    arguments = st_init_numtable();
+    st_insert(scopes, scope, (st_data_t)arguments);
+  }
+
+  if (!GQL_INDEX_LOOKUP(arguments, args, bucket))
+  {
+    bucket = ALLOC(struct gql_index_bucket);
+    bucket->size = 0;
+    bucket->capa = 4;
+    bucket->slots = ALLOC_N(long, bucket->capa);
+    st_insert(arguments, args, (st_data_t)bucket);
+  }
+
+  return bucket;
+}
+
+// Remove the bucket and any empty parent table of the given path
+void gql_index_cleanup(struct gql_index *index, st_data_t field, st_data_t scope, st_data_t args)
+{
+  st_table *scopes, *arguments;
+  struct gql_index_bucket *bucket;
+
+  GQL_INDEX_LOOKUP(index->fields, field, scopes);
+  GQL_INDEX_LOOKUP(scopes, scope, arguments);
+  st_delete(arguments, &args, (st_data_t *)&bucket);
+  gql_index_free_bucket(args, (st_data_t)bucket, 0);
+  if (arguments->num_entries > 0)
+    return;
+
+  st_delete(scopes, &scope, NULL);
+  st_free_table(arguments);
+  if (scopes->num_entries > 0)
+    return;
+
+  st_delete(index->fields, &field, NULL);
+  st_free_table(scopes);
+}
+
+// Push all the sids in the bucket to the result
+void gql_index_collect_bucket(struct gql_index *index, struct gql_index_bucket *bucket, VALUE result)
+{
+  for (long i = 0; i < bucket->size; i++)
+    rb_ary_push(result, index->entries[bucket->slots[i]].sid);
+}
+
+// The state of a search, which is passed down through the tables
+struct gql_index_search
+{
+  struct gql_index *index;
+  VALUE scopes;
+  VALUE args;
+  VALUE result;
+};
+
+int gql_index_search_args(st_data_t key, st_data_t value, st_data_t arg)
+{
+  struct gql_index_search *search = (struct gql_index_search *)arg;
+  gql_index_collect_bucket(search->index, (struct gql_index_bucket *)value, search->result);
+  return ST_CONTINUE;
+}
+
+// Collect from a table either all its items or the ones in the list of keys
+void gql_index_search_level(st_table *table, VALUE keys, int (*callback)(st_data_t, st_data_t, st_data_t), struct gql_index_search *search)
+{
+  st_data_t value;
+
+  if (NIL_P(keys))
+  {
+    st_foreach(table, callback, (st_data_t)search);
+  }
+  else if (RB_TYPE_P(keys, T_ARRAY))
+  {
+    for (long i = 0; i < RARRAY_LEN(keys); i++)
+      if (st_lookup(table, GQL_INDEX_KEY(rb_ary_entry(keys, i)), &value))
+        callback(0, value, (st_data_t)search);
+  }
+  else if (st_lookup(table, GQL_INDEX_KEY(keys), &value))
+  {
+    callback(0, value, (st_data_t)search);
+  }
+}
+
+int gql_index_search_scopes(st_data_t key, st_data_t value, st_data_t arg)
+{
+  struct gql_index_search *search = (struct gql_index_search *)arg;
+  gql_index_search_level((st_table *)value, search->args, gql_index_search_args, search);
+  return ST_CONTINUE;
+}
+
+int gql_index_search_fields(st_data_t key, st_data_t value, st_data_t arg)
+{
+  struct gql_index_search *search = (struct gql_index_search *)arg;
+  gql_index_search_level((st_table *)value, search->scopes, gql_index_search_scopes, search);
+  return ST_CONTINUE;
+}
+
+/* METHODS */
+
+// Add the given +sid+ under the +field+, +scope+, and +args+ keys and return
+// the slot that it occupies
+VALUE gql_index_add(VALUE self, VALUE sid, VALUE field, VALUE scope, VALUE args)
+{
+  long slot;
+  struct gql_index_entry *entry;
+  struct gql_index *index = gql_index_get(self);
+  struct gql_index_bucket *bucket;
+
+  // Prepare everything that can raise before touching the index
+  st_data_t field_key = GQL_INDEX_KEY(field);
+  st_data_t scope_key = GQL_INDEX_KEY(scope);
+  st_data_t args_key = GQL_INDEX_KEY(args);
+  sid = rb_str_new_frozen(sid);
+  bucket = gql_index_bucket_for(index, field_key, scope_key, args_key);
+
+  // Reuse a free slot or add a new one
+  if (index->free_slot >= 0)
+  {
+    slot = index->free_slot;
+    index->free_slot = index->entries[slot].position;
+  }
+  else
+  {
+    if (index->entries_size == index->entries_capa)
+    {
+      index->entries_capa = index->entries_capa == 0 ? 64 : index->entries_capa * 2;
+      REALLOC_N(index->entries, struct gql_index_entry, index->entries_capa);
+    }
+
+    slot = index->entries_size++;
+  }
+
+  entry = &index->entries[slot];
+  entry->sid = sid;
+  entry->field = field_key;
+  entry->scope = scope_key;
+  entry->args = args_key;
+
+  if (bucket->size == bucket->capa)
+  {
+    bucket->capa *= 2;
+    REALLOC_N(bucket->slots, long, bucket->capa);
+  }
+
+  entry->position = bucket->size;
+  bucket->slots[bucket->size++] = slot;
+  index->size++;
+
+  return LONG2NUM(slot);
+}
+
+// Remove the subscription from the given +slot+, returning its sid
+VALUE gql_index_remove(VALUE self, VALUE rb_slot)
+{
+  VALUE sid;
+  st_table *scopes, *arguments;
+  struct gql_index_entry *entry;
+  struct gql_index_bucket *bucket;
+  struct gql_index *index = gql_index_get(self);
+  long slot = NUM2LONG(rb_slot);
+
+  if (slot < 0 || slot >= index->entries_size || NIL_P(index->entries[slot].sid))
+    return Qnil;
+
+  entry = &index->entries[slot];
+  GQL_INDEX_LOOKUP(index->fields, entry->field, scopes);
+  GQL_INDEX_LOOKUP(scopes, entry->scope, arguments);
+  GQL_INDEX_LOOKUP(arguments, entry->args, bucket);
+
+  // Move the last slot of the bucket to the position of the removed one
+  bucket->slots[entry->position] = bucket->slots[--bucket->size];
+  index->entries[bucket->slots[entry->position]].position = entry->position;
+
+  if (bucket->size == 0)
+    gql_index_cleanup(index, entry->field, entry->scope, entry->args);
+
+  // Chain the slot as free
+  sid = entry->sid;
+  entry->sid = Qnil;
+  entry->position = index->free_slot;
+  index->free_slot = slot;
+  index->size--;
+
+  return sid;
+}
+
+// Find all the sids that matches the given keys. Each one of them can be nil,
+// which means any, a single key, or an array of keys
+VALUE gql_index_search(VALUE self, VALUE fields, VALUE scopes, VALUE args)
+{
+  struct gql_index_search search;
+  search.index = gql_index_get(self);
+  search.scopes = scopes;
+  search.args = args;
+  search.result = rb_ary_new();
+
+  gql_index_search_level(search.index->fields, fields, gql_index_search_fields, &search);
+  return search.result;
+}
+
+// The number of subscriptions in the index
+VALUE gql_index_size(VALUE self)
+{
+  return LONG2NUM(gql_index_get(self)->size);
+}
+
+// The amount of memory allocated by the index, in bytes
+VALUE gql_index_memsize_rb(VALUE self)
+{
+  return SIZET2NUM(gql_index_memsize(gql_index_get(self)));
+}
+
+void Init_gql_subscription_index(void)
+{
+  gql_cSubscriptionIndex = rb_define_class_under(GQLParser, "SubscriptionIndex", rb_cObject);
+  rb_define_alloc_func(gql_cSubscriptionIndex, gql_index_alloc);
+  rb_define_method(gql_cSubscriptionIndex, "add", gql_index_add, 4);
+  rb_define_method(gql_cSubscriptionIndex, "remove", gql_index_remove, 1);
+  rb_define_method(gql_cSubscriptionIndex, "search", gql_index_search, 3);
+  rb_define_method(gql_cSubscriptionIndex, "size", gql_index_size, 0);
+  rb_define_method(gql_cSubscriptionIndex, "memsize", gql_index_memsize_rb, 0);
+}
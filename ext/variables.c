@@ -0,0 +1,507 @@
+#include "ruby.h"
+#include "ruby/encoding.h"
+#include "shared.h"
+
+// The maximum nesting of arrays and objects accepted from the variables
+#define GQL_JSON_MAX_DEPTH 512
+
+#define GQL_JSON_IGNORE(x) (x == ' ' || x == '\n' || x == '\r' || x == '\t')
+#define GQL_JSON_CHAR(json) ((json)->pos < (json)->size ? (json)->doc[(json)->pos] : '\0')
+#define GQL_JSON_LOOK(json, bytes) ((json)->pos + bytes < (json)->size ? (json)->doc[(json)->pos + bytes] : '\0')
+
+// The kinds of types that are coerced natively, anything else is returned as
+// it was decoded and Ruby validates it against the actual type
+enum gql_variable_kind
+{
+  gql_vk_other   = 0x0,
+  gql_vk_int     = 0x1,
+  gql_vk_float   = 0x2,
+  gql_vk_string  = 0x3,
+  gql_vk_boolean = 0x4,
+  gql_vk_id      = 0x5,
+};
+
+// The definition of a variable, as in the result of +gql_parse_type+
+struct gql_variable_def
+{
+  VALUE name;
+  enum gql_variable_kind kind;
+  long dimensions;
+  long nullability;
+};
+
+struct gql_json
+{
+  const char *doc;
+  long pos;
+  long size;
+  int depth;
+};
+
+VALUE gql_eVariablesError;
+
+VALUE gql_json_value(struct gql_json *json);
+
+/* JSON DECODER */
+
+// Central error method
+NORETURN(void gql_json_error(struct gql_json *json));
+void gql_json_error(struct gql_json *json)
+{
+  VALUE token;
+  if (json->pos < json->size)
+    token = rb_str_new(json->doc + json->pos, 1);
+  else
+    token = rb_str_new2("EOF");
+
+  const char *message = "Variables parser error: unexpected \"%" PRIsVALUE "\" at %ld";
+  rb_raise(gql_eParserError, message, token, json->pos);
+}
+
+// Skip all the whitespace
+void gql_json_skip(struct gql_json *json)
+{
+  while (json->pos < json->size && GQL_JSON_IGNORE(json->doc[json->pos]))
+    json->pos++;
+}
+
+// Make sure that the current position has the given keyword
+void gql_json_expect(struct gql_json *json, const char *keyword, long size)
+{
+  if (json->pos + size > json->size || memcmp(json->doc + json->pos, keyword, size) != 0)
+    gql_json_error(json);
+
+  json->pos += size;
+}
+
+// Read exactly 4 hex digits of a unicode escape
+long gql_json_hex(struct gql_json *json)
+{
+  long result = 0;
+  for (int i = 0; i < 4; i++)
+  {
+    char c = GQL_JSON_CHAR(json);
+    result <<= 4;
+
+    if (c >= '0' && c <= '9')
+      result |= c - '0';
+    else if (c >= 'a' && c <= 'f')
+      result |= c - 'a' + 10;
+    else if (c >= 'A' && c <= 'F')
+      result |= c - 'A' + 10;
+    else
+      gql_json_error(json);
+
+    json->pos++;
+  }
+
+  return result;
+}
+
+// Read a unicode escape, which may be a surrogate pair, and add it as UTF-8
+void gql_json_unicode(struct gql_json *json, VALUE result)
+{
+  long code = gql_json_hex(json);
+
+  if (code >= 0xD800 && code <= 0xDBFF)
+  {
+    if (GQL_JSON_CHAR(json) != '\\' || GQL_JSON_LOOK(json, 1) != 'u')
+      gql_json_error(json);
+
+    json->pos += 2;
+    long low = gql_json_hex(json);
+    if (low < 0xDC00 || low > 0xDFFF)
+      gql_json_error(json);
+
+    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+  }
+  else if (code >= 0xDC00 && code <= 0xDFFF)
+    gql_json_error(json);
+
+  char buffer[4];
+  int size = rb_enc_mbcput((unsigned int)code, buffer, rb_utf8_encoding());
+  rb_str_cat(result, buffer, size);
+}
+
+// Read a string, only allocating a buffer when it has escaped characters
+VALUE gql_json_string(struct gql_json *json)
+{
+  long start = ++json->pos;
+  while (json->pos < json->size && json->doc[json->pos] != '"' && json->doc[json->pos] != '\\')
+  {
+    if ((unsigned char)json->doc[json->pos] < 0x20)
+      gql_json_error(json);
+
+    json->pos++;
+  }
+
+  VALUE result = rb_utf8_str_new(json->doc + start, json->pos - start);
+  while (GQL_JSON_CHAR(json) == '\\')
+  {
+    json->pos++;
+    switch (GQL_JSON_CHAR(json))
+    {
+    case '"': rb_str_cat(result, "\"", 1); break;
+    case '\\': rb_str_cat(result, "\\", 1); break;
+    case '/': rb_str_cat(result, "/", 1); break;
+    case 'b': rb_str_cat(result, "\b", 1); break;
+    case 'f': rb_str_cat(result, "\f", 1); break;
+    case 'n': rb_str_cat(result, "\n", 1); break;
+    case 'r': rb_str_cat(result, "\r", 1); break;
+    case 't': rb_str_cat(result, "\t", 1); break;
+    case 'u':
+      json->pos++;
+      gql_json_unicode(json, result);
+      json->pos--;
+      break;
+    default:
+      gql_json_error(json);
+    }
+
+    start = ++json->pos;
+    while (json->pos < json->size && json->doc[json->pos] != '"' && json->doc[json->pos] != '\\')
+    {
+      if ((unsigned char)json->doc[json->pos] < 0x20)
+        gql_json_error(json);
+
+      json->pos++;
+    }
+
+    rb_str_cat(result, json->doc + start, json->pos - start);
+  }
+
+  if (GQL_JSON_CHAR(json) != '"')
+    gql_json_error(json);
+
+  json->pos++;
+  return result;
+}
+
+// Read a number, which turns into a float when it has a fraction or exponent
+VALUE gql_json_number(struct gql_json *json)
+{
+  long start = json->pos;
+  int is_float = 0;
+
+  if (GQL_JSON_CHAR(json) == '-')
+    json->pos++;
+
+  if (GQL_JSON_CHAR(json) == '0')
+    json->pos++;
+  else if (GQL_S_DIGIT(GQL_JSON_CHAR(json)))
+    while (GQL_S_DIGIT(GQL_JSON_CHAR(json)))
+      json->pos++;
+  else
+    gql_json_error(json);
+
+  if (GQL_JSON_CHAR(json) == '.')
+  {
+    is_float = 1;
+    json->pos++;
+    if (!GQL_S_DIGIT(GQL_JSON_CHAR(json)))
+      gql_json_error(json);
+
+    while (GQL_S_DIGIT(GQL_JSON_CHAR(json)))
+      json->pos++;
+  }
+
+  if (GQL_JSON_CHAR(json) == 'e' || GQL_JSON_CHAR(json) == 'E')
+  {
+    is_float = 1;
+    json->pos++;
+    if (GQL_JSON_CHAR(json) == '+' || GQL_JSON_CHAR(json) == '-')
+      json->pos++;
+
+    if (!GQL_S_DIGIT(GQL_JSON_CHAR(json)))
+      gql_json_error(json);
+
+    while (GQL_S_DIGIT(GQL_JSON_CHAR(json)))
+      json->pos++;
+  }
+
+  VALUE source = rb_str_new(json->doc + start, json->pos - start);
+  return is_float ? rb_float_new(rb_str_to_dbl(source, 0)) : rb_str_to_inum(source, 10, 0);
+}
+
+// Increase the depth and make sure it is within the limit
+void gql_json_nest(struct gql_json *json)
+{
+  if (++json->depth > GQL_JSON_MAX_DEPTH)
+    rb_raise(gql_eParserError, "Variables parser error: nesting of %d is too deep", json->depth);
+
+  json->pos++;
+  gql_json_skip(json);
+}
+
+VALUE gql_json_array(struct gql_json *json)
+{
+  VALUE result = rb_ary_new();
+  gql_json_nest(json);
+
+  if (GQL_JSON_CHAR(json) != ']')
+  {
+    while (1)
+    {
+      rb_ary_push(result, gql_json_value(json));
+      gql_json_skip(json);
+
+      if (GQL_JSON_CHAR(json) != ',')
+        break;
+
+      json->pos++;
+    }
+  }
+
+  if (GQL_JSON_CHAR(json) != ']')
+    gql_json_error(json);
+
+  json->pos++;
+  json->depth--;
+  return result;
+}
+
+// Read the key of an object, making sure it is followed by a colon
+VALUE gql_json_key(struct gql_json *json)
+{
+  gql_json_skip(json);
+  if (GQL_JSON_CHAR(json) != '"')
+    gql_json_error(json);
+
+  VALUE key = gql_json_string(json);
+  gql_json_skip(json);
+
+  if (GQL_JSON_CHAR(json) != ':')
+    gql_json_error(json);
+
+  json->pos++;
+  return key;
+}
+
+VALUE gql_json_object(struct gql_json *json)
+{
+  VALUE result = rb_hash_new();
+  gql_json_nest(json);
+
+  if (GQL_JSON_CHAR(json) != '}')
+  {
+    while (1)
+    {
+      VALUE key = gql_json_key(json);
+      rb_hash_aset(result, key, gql_json_value(json));
+      gql_json_skip(json);
+
+      if (GQL_JSON_CHAR(json) != ',')
+        break;
+
+      json->pos++;
+    }
+  }
+
+  if (GQL_JSON_CHAR(json) != '}')
+    gql_json_error(json);
+
+  json->pos++;
+  json->depth--;
+  return result;
+}
+
+VALUE gql_json_value(struct gql_json *json)
+{
+  gql_json_skip(json);
+
+  switch (GQL_JSON_CHAR(json))
+  {
+  case '{': return gql_json_object(json);
+  case '[': return gql_json_array(json);
+  case '"': return gql_json_string(json);
+  case 't': gql_json_expect(json, "true", 4); return Qtrue;
+  case 'f': gql_json_expect(json, "false", 5); return Qfalse;
+  case 'n': gql_json_expect(json, "null", 4); return Qnil;
+  default:
+    if (GQL_JSON_CHAR(json) == '-' || GQL_S_DIGIT(GQL_JSON_CHAR(json)))
+      return gql_json_number(json);
+
+    gql_json_error(json);
+  }
+}
+
+/* COERCION */
+
+// Find the kind of the type from its name
+enum gql_variable_kind gql_variable_kind_of(VALUE type_name)
+{
+  const char *name = RSTRING_PTR(type_name);
+  long size = RSTRING_LEN(type_name);
+
+  if (size == 3 && memcmp(name, "Int", 3) == 0)
+    return gql_vk_int;
+  else if (size == 5 && memcmp(name, "Float", 5) == 0)
+    return gql_vk_float;
+  else if (size == 6 && memcmp(name, "String", 6) == 0)
+    return gql_vk_string;
+  else if (size == 7 && memcmp(name, "Boolean", 7) == 0)
+    return gql_vk_boolean;
+  else if (size == 2 && memcmp(name, "ID", 2) == 0)
+    return gql_vk_id;
+
+  return gql_vk_other;
+}
+
+// Coerce a scalar value, returning Qundef when it is not valid
+VALUE gql_variable_coerce_scalar(VALUE value, enum gql_variable_kind kind)
+{
+  switch (kind)
+  {
+  case gql_vk_int:
+    if (!FIXNUM_P(value))
+      return Qundef;
+
+    return (FIX2LONG(value) >= -2147483648L && FIX2LONG(value) <= 2147483647L) ? value : Qundef;
+  case gql_vk_float:
+    if (RB_FLOAT_TYPE_P(value))
+      return value;
+
+    return RB_INTEGER_TYPE_P(value) ? rb_Float(value) : Qundef;
+  case gql_vk_string:
+    return RB_TYPE_P(value, T_STRING) ? value : Qundef;
+  case gql_vk_boolean:
+    return (value == Qtrue || value == Qfalse) ? value : Qundef;
+  case gql_vk_id:
+    if (RB_TYPE_P(value, T_STRING))
+      return value;
+
+    return RB_INTEGER_TYPE_P(value) ? rb_obj_as_string(value) : Qundef;
+  default:
+    return value;
+  }
+}
+
+// Coerce the value against the definition, starting from the outer list,
+// collecting any problem into the +errors+
+VALUE gql_variable_coerce(VALUE value, struct gql_variable_def *def, long level, VALUE errors)
+{
+  if (NIL_P(value))
+  {
+    if (def->nullability & (1L << level))
+      rb_ary_push(errors, rb_sprintf("Variable $%" PRIsVALUE " can not be null", def->name));
+
+    return Qnil;
+  }
+
+  // Lists accept a single value, as if it was a list of one element
+  if (level < def->dimensions)
+  {
+    if (!RB_TYPE_P(value, T_ARRAY))
+      value = rb_ary_new_from_values(1, &value);
+
+    for (long i = 0; i < RARRAY_LEN(value); i++)
+      rb_ary_store(value, i, gql_variable_coerce(RARRAY_AREF(value, i), def, level + 1, errors));
+
+    return value;
+  }
+
+  VALUE result = gql_variable_coerce_scalar(value, def->kind);
+  if (result != Qundef)
+    return result;
+
+  rb_ary_push(errors, rb_sprintf("Invalid value %+" PRIsVALUE " provided to $%" PRIsVALUE " variable", value, def->name));
+  return value;
+}
+
+// Read the definition of a variable, as [type_name, dimensions, nullability]
+int gql_variable_def_from(VALUE definitions, VALUE key, struct gql_variable_def *def)
+{
+  if (NIL_P(definitions))
+    return 0;
+
+  VALUE type = rb_hash_lookup(definitions, key);
+  if (!RB_TYPE_P(type, T_ARRAY) || RARRAY_LEN(type) < 3)
+    return 0;
+
+  VALUE type_name = rb_String(RARRAY_AREF(type, 0));
+  def->name = key;
+  def->kind = gql_variable_kind_of(type_name);
+  def->dimensions = NUM2LONG(RARRAY_AREF(type, 1));
+  def->nullability = NUM2LONG(RARRAY_AREF(type, 2));
+  return 1;
+}
+
+/* METHOD */
+
+// Decode the given JSON object of variables. When definitions are provided,
+// as a hash of names and their type as in [type_name, dimensions, nullability],
+// values are coerced while decoding and all the problems are reported at once
+VALUE gql_decode_variables(int argc, VALUE *argv, VALUE self)
+{
+  VALUE source, definitions;
+  rb_scan_args(argc, argv, "11", &source, &definitions);
+
+  if (!RB_TYPE_P(source, T_STRING))
+    rb_raise(rb_eArgError, "%+" PRIsVALUE " is not a string", source);
+
+  if (!NIL_P(definitions))
+    Check_Type(definitions, T_HASH);
+
+  struct gql_json json = {RSTRING_PTR(source), 0, RSTRING_LEN(source), 0};
+  VALUE result = rb_hash_new();
+  VALUE errors = rb_ary_new();
+  struct gql_variable_def def;
+
+  // An empty document or a null means that no variables were given
+  gql_json_skip(&json);
+  if (GQL_JSON_CHAR(&json) == 'n')
+    gql_json_expect(&json, "null", 4);
+  else if (json.pos < json.size)
+  {
+    if (GQL_JSON_CHAR(&json) != '{')
+      gql_json_error(&json);
+
+    gql_json_nest(&json);
+    if (GQL_JSON_CHAR(&json) != '}')
+    {
+      while (1)
+      {
+        VALUE key = gql_json_key(&json);
+        VALUE value = gql_json_value(&json);
+
+        if (gql_variable_def_from(definitions, key, &def))
+          value = gql_variable_coerce(value, &def, 0, errors);
+
+        rb_hash_aset(result, key, value);
+        gql_json_skip(&json);
+
+        if (GQL_JSON_CHAR(&json) != ',')
+          break;
+
+        json.pos++;
+      }
+    }
+
+    if (GQL_JSON_CHAR(&json) != '}')
+      gql_json_error(&json);
+
+    json.pos++;
+  }
+
+  // Nothing but whitespace is allowed after the object
+  gql_json_skip(&json);
+  if (json.pos < json.size)
+    gql_json_error(&json);
+
+  if (RARRAY_LEN(errors) > 0)
+  {
+    VALUE exception = rb_exc_new_str(gql_eVariablesError, rb_ary_join(errors, rb_str_new2(", ")));
+    rb_ivar_set(exception, rb_intern("@errors"), errors);
+    rb_exc_raise(exception);
+  }
+
+  return result;
+}
+
+void Init_gql_variables(void)
+{
+  rb_define_singleton_method(GQLParser, "decode_variables", gql_decode_variables, -1);
+
+  gql_eVariablesError = rb_define_class_under(GQLParser, "VariablesError", gql_eParserError);
+  rb_define_attr(gql_eVariablesError, "errors", 1, 0);
+}
@@ -2,8 +2,11 @@
 
 require 'i18n'
 require 'zlib'
+require 'digest'
 require 'active_model'
 require 'active_support'
+require 'concurrent/executor/fixed_thread_pool'
+require 'concurrent/promises'
 
 require 'active_support/core_ext/module/attribute_accessors_per_thread'
 require 'active_support/core_ext/string/strip'
@@ -141,6 +144,26 @@ module Rails
         (value.is_a?(Enumerable) || value.respond_to?(:to_ary)) ? value : value.then
       end
 
+      # Run the given block in a thread of the given +pool+, wrapped by the
+      # application executor, so that resources like database connections
+      # are properly released
+      def future_on(pool, &block)
+        Concurrent::Promises.future_on(pool) do
+          executor = ::Rails.application&.executor
+          executor.nil? ? block.call : executor.wrap(&block)
+        end
+      end
+
+      # Wait for all the given +futures+, allowing them to load constants in
+      # the meantime, and return them
+      def wait_futures(futures)
+        ActiveSupport::Dependencies.interlock.permit_concurrent_loads do
+          Concurrent::Promises.zip_futures(*futures).wait
+        end
+
+        futures
+      end
+
       # Load a given +list+ of dependencies from the given +type+
       def add_dependencies(type, *list, to: :base)
         ref = config.known_dependencies
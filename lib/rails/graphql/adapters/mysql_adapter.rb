@@ -51,6 +51,12 @@ module Rails
               yield(column.name, type, array: (base_type == 'set'))
             end
           end
+
+          # MySQL does not always use indexes for row values comparison, so
+          # the condition is expanded column by column
+          def mysql_keyset_condition(columns, values)
+            expanded_keyset_condition(columns, values)
+          end
       end
     end
 
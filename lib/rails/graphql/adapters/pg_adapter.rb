@@ -45,6 +45,11 @@ module Rails
               yield(column.name, type, array: type_name.include?('[]'))
             end
           end
+
+          # Row values comparison can use a composite index directly
+          def pg_keyset_condition(columns, values)
+            row_keyset_condition(columns, values)
+          end
       end
     end
 
@@ -34,6 +34,11 @@ module Rails
               yield(column.name, type)
             end
           end
+
+          # Row values are supported since SQLite 3.15
+          def sqlite_keyset_condition(columns, values)
+            row_keyset_condition(columns, values)
+          end
       end
     end
 
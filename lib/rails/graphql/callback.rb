@@ -118,30 +118,50 @@ module Rails
         # Read the arguments needed for a block then collect them from the
         # event and return the execution args
         def collect_parameters(event, send_args, block = @block)
-          args_source = event.send(:args_source)
-          send_args[0] += @pre_args.deep_dup
-          send_args[1].merge!(@pre_xargs.deep_dup)
-          return send_args unless inject_arguments?
+          send_args[0] += @pre_args.deep_dup unless @pre_args.empty?
+          send_args[1].merge!(@pre_xargs.deep_dup) unless @pre_xargs.empty?
+          return send_args if (plan = parameters_plan(block)).empty?
 
-          # TODO: Maybe we need to turn procs into lambdas so the optional
-          # arguments doesn't suffer any kind of change
-          idx = -1
-          block.parameters.each_with_object(send_args) do |(type, name), result|
+          args_source = event.send(:args_source)
+          plan.each_with_object(send_args) do |(type, name, idx), result|
             case type
-            when :opt, :req
-              idx += 1
-              next unless callback_inject_arguments
+            when :req
               result[0][idx] ||= event.parameter(name) if event.parameter?(name)
             when :keyreq
-              next unless callback_inject_named_arguments
               result[1][name] ||= args_source[name]
             when :key
-              next unless callback_inject_named_arguments
               result[1][name] ||= args_source[name] if args_source.key?(name)
             end
           end
         end
 
+        # Plan which parameters of the block will be injected, so that its
+        # signature is checked only once for the current settings. Methods are
+        # planned by their definition, since each instance has its own object
+        # TODO: Maybe we need to turn procs into lambdas so the optional
+        # arguments doesn't suffer any kind of change
+        def parameters_plan(block)
+          settings = (callback_inject_arguments ? 1 : 0) |
+            (callback_inject_named_arguments ? 2 : 0)
+
+          key = block.is_a?(::Method) ? block.unbind : block
+          plans = (@parameters_plans ||= {})[settings] ||= {}
+          return plans[key] if plans.key?(key)
+
+          idx = -1
+          plan = block.parameters.each_with_object([]) do |(type, name), result|
+            case type
+            when :opt, :req
+              idx += 1
+              result << [:req, name, idx].freeze if settings[0] == 1
+            when :keyreq, :key
+              result << [type, name].freeze if settings[1] == 1
+            end
+          end
+
+          plans[key] = plan.freeze
+        end
+
         # Check if the callback should inject arguments
         def inject_arguments?
           callback_inject_arguments || callback_inject_named_arguments
@@ -7,37 +7,82 @@ module Rails
       #
       # This collector helps building a JSON response using the hash approach,
       # where the value is kept as an hash and later turn into a string
+      #
+      # Keys are stored as frozen strings, so the frozen response keys of the
+      # components are shared by every row. Lists with a known length are
+      # allocated up front and filled by position, and the rows of a list only
+      # get their hash once something is added to them. Hashes are created
+      # with the width of the selection or of the previous row when the Ruby
+      # version supports it.
       class HashCollector
+        # Check if hashes can be created with a given capacity
+        SIZED_HASH = ::Hash.instance_method(:initialize).parameters.include?([:key, :capacity])
+
+        # The characters that +ActiveSupport::JSON+ escapes when encoding
+        ESCAPED_CHARS = {
+          "\u2028" => '\u2028',
+          "\u2029" => '\u2029',
+          '>'      => '\u003e',
+          '<'      => '\u003c',
+          '&'      => '\u0026',
+        }.freeze
+
+        ESCAPE_REGEX = /[\u2028\u2029]/u
+        ESCAPE_HTML_REGEX = /[\u2028\u2029><&]/u
+
         def initialize(request)
           @request = request
           @stack = []
           @data = {}
+          @index = 0
+          @width = nil
         end
 
-        # Shortcut for starting and ending a stack while execute a block.
-        def with_stack(key, array: false, plain: false)
+        # Shortcut for starting and ending a stack while execute a block. The
+        # +size+ is how many keys or items are expected in it, when known
+        def with_stack(key, array: false, plain: false, size: nil)
           return unless block_given?
-          start_stack(array, plain)
+          start_stack(array, plain, size)
           yield
           end_stack(key, array, plain)
         rescue
-          pop_size = array && !plain ? 2 : 1
-          @data = @stack.pop(pop_size).first
+          @stack.pop if array && !plain
+          @width = @stack.pop
+          @index = @stack.pop
+          @data = @stack.pop
           raise
         end
 
         # Add the given +value+ to the given +key+.
         def add(key, value)
-          @data.is_a?(::Array) ? @data << value : @data[key.to_s] = value
+          data = (@data ||= new_hash(@width))
+          return data[frozen_key(key)] = value unless data.is_a?(::Array)
+
+          data[@index] = value
+          @index += 1
+          value
         end
 
         # Check if a given +key+ has already been added to the current data
         def key?(key)
-          !@data.is_a?(::Array) && @data.key?(key)
+          @data.is_a?(::Hash) && @data.key?(key)
         end
 
         alias safe_add add
 
+        # Run the given block and return the value that was added to the given
+        # +key+, if any
+        def capture(key)
+          yield
+          @data[frozen_key(key)] if @data.is_a?(::Hash)
+        end
+
+        # Append all the values added to the top level of the +other+ collector
+        # into the current level of this one
+        def merge!(other)
+          (@data ||= new_hash(@width)).merge!(other.to_h)
+        end
+
         # Serialize is a helper to call the correct method on types before add
         def serialize(klass, key, value)
           add(key, klass.as_json(value))
@@ -45,9 +90,13 @@ module Rails
 
         # Mark the start of a new element on the array.
         def next
-          return unless @stack.last.is_a?(::Array)
-          @stack.last << @data
-          @data = {}
+          return unless (list = @stack.last).is_a?(::Array)
+
+          row = @data || {}
+          list[@index] = row
+          @index += 1
+          @width = row.size
+          @data = nil
         end
 
         # Append to the response all the errors that happened during the
@@ -70,11 +119,20 @@ module Rails
 
         alias as_json to_h
 
-        # Generate the JSON string result
+        # Generate the JSON string result. Everything added is already in its
+        # JSON form, so it is generated directly, and then only the characters
+        # that ActiveSupport would have escaped are replaced
         def to_s
-          GraphQL.config.encode_with_active_support? \
-            ? ::ActiveSupport::JSON.encode(@data) \
-            : ::JSON.generate(@data)
+          return ::JSON.generate(@data) unless GraphQL.config.encode_with_active_support?
+
+          result = ::JSON.generate(@data)
+          regex = ::ActiveSupport.escape_html_entities_in_json ? ESCAPE_HTML_REGEX : ESCAPE_REGEX
+          result.gsub!(regex, ESCAPED_CHARS) || result
+        rescue ::JSON::GeneratorError
+          # Values like NaN and Infinity can't be generated, but ActiveSupport
+          # turns them into null
+          raise unless GraphQL.config.encode_with_active_support?
+          ::ActiveSupport::JSON.encode(@data)
         end
 
         alias to_json to_s
@@ -83,19 +141,45 @@ module Rails
 
           # Start a new part of the collector. When set +as_array+, the result
           # of the stack will be an array.
-          def start_stack(as_array = false, plain_array = false)
-            @stack << @data
-            @stack << [] if as_array && !plain_array
-            @data = as_array && plain_array ? [] : {}
+          def start_stack(as_array = false, plain_array = false, size = nil)
+            @stack << @data << @index << @width
+            @index = 0
+            @width = nil
+
+            if as_array && !plain_array
+              @stack << new_array(size)
+              @data = nil
+            else
+              @data = as_array ? new_array(size) : new_hash(size)
+            end
           end
 
           # Finalize a stack and set the result on the given +key+.
           def end_stack(key, as_array = false, plain_array = false)
             result = as_array && !plain_array ? @stack.pop : @data
+            result.pop(result.size - @index) if as_array && @index < result.size
 
+            @width = @stack.pop
+            @index = @stack.pop
             @data = @stack.pop
             add(key, result)
           end
+
+          # Keys from the components are already frozen, so they are used as
+          # they are, and the others are deduplicated
+          def frozen_key(key)
+            key.is_a?(::String) && key.frozen? ? key : -key.to_s
+          end
+
+          # A list with all the positions for the expected number of items
+          def new_array(size)
+            size.nil? ? [] : ::Array.new(size)
+          end
+
+          # A hash with room for the expected number of keys
+          def new_hash(size)
+            SIZED_HASH && !size.nil? ? ::Hash.new(capacity: size) : {}
+          end
       end
     end
   end
@@ -8,9 +8,13 @@ module Rails
       # This collector helps building a JSON response using the string approach,
       # which has better performance, since all the encoding is performed up
       # front. The drawback is that it can't return a hash.
+      #
+      # Frozen keys, like the ones from the components of the request, have
+      # their encoded version stored, so rows of a list only append them.
       class JsonCollector
         def initialize(request)
           @request = request
+          @encoded_keys = {}.compare_by_identity
 
           @current_keys = Set.new
           @stack_keys = []
@@ -25,8 +29,9 @@ module Rails
           @stack_plain_array = []
         end
 
-        # Shortcut for starting and ending a stack while execute a block.
-        def with_stack(key, array: false, plain: false)
+        # Shortcut for starting and ending a stack while execute a block. The
+        # expected +size+ is not used, since everything is a string already
+        def with_stack(key, array: false, plain: false, size: nil)
           return unless block_given?
           start_stack(array, plain)
           yield
@@ -59,9 +64,11 @@ module Rails
           @current_keys << key
 
           if @current_array
+            @added_at = @current_value.pos
             @current_value << value
           else
-            @current_value << '"' << +key.to_s << '"' << ':' << +value.to_s
+            @added_at = (@current_value << encoded_key(key)).pos
+            @current_value << value.to_s
           end
         end
 
@@ -70,6 +77,30 @@ module Rails
           @current_keys.include?(key)
         end
 
+        # Run the given block and return the encoded value that was added to
+        # the given +key+, if any. The value is the last thing added to the
+        # current level, starting where the +add+ recorded it
+        def capture(key)
+          start, current = @current_value.pos, @current_value
+          yield
+          return if !current.equal?(@current_value) || current.pos == start
+          return if @added_at.nil? || @added_at < start || !@current_keys.include?(key)
+
+          current.string.byteslice(@added_at..-1)
+        end
+
+        # Append all the values added to the top level of the +other+ collector
+        # into the current level of this one
+        def merge!(other)
+          value = other.current_value
+          return if value.pos.zero?
+
+          (@current_value << ',') if @current_value.pos > 0
+          @current_keys.merge(other.current_keys)
+          @added_at = nil
+          @current_value << value.string
+        end
+
         # Same as +add+ but this always encode the +value+ beforehand.
         def safe_add(key, value)
           add(key, value.nil? ? 'null' : value.to_json)
@@ -101,8 +132,20 @@ module Rails
 
         alias to_json to_s
 
+        protected
+
+          # The values and keys added to the current level, which other
+          # collectors read when merging this one
+          attr_reader :current_value, :current_keys
+
         private
 
+          # Get the encoded version of the key, followed by the separator
+          def encoded_key(key)
+            return +"\"#{key}\":" unless key.frozen?
+            @encoded_keys[key] ||= -"\"#{key}\":"
+          end
+
           # Start a new part of the collector. When set +as_array+, the result
           # of the stack will be enclosed by +[]+.
           def start_stack(as_array = false, plain_array = false)
@@ -134,9 +134,55 @@ module Rails
       config.request_strategies = [
         'Rails::GraphQL::Request::Strategy::MultiQueryStrategy',
         'Rails::GraphQL::Request::Strategy::SequencedStrategy',
-        # 'Rails::GraphQL::Request::Strategy::CachedStrategy',
+        'Rails::GraphQL::Request::Strategy::CachedStrategy',
       ]
 
+      # When set with the size of a pool of threads, requests that only contain
+      # queries will have their operations prepared and resolved concurrently,
+      # after all of them have been organized. Only enable this if your resolvers
+      # are thread-safe. This can also be set per Schema.
+      config.concurrent_multi_query = false
+
+      # When enabled, the resolvers of sibling fields are called before any of
+      # them is added to the response. Resolvers can then return promises, like
+      # `Concurrent::Promises::Future` or `ActiveRecord::Promise`, that will run
+      # concurrently and only be awaited when writing. This can also be set per
+      # Schema.
+      config.async_field_resolution = false
+
+      # When enabled, the organized version of the requested documents will be
+      # stored in the cache, based on the version of the type map, so that
+      # identical documents can skip both the parse and the organize steps. The
+      # version changes when the schema is reloaded, unless it was manually set.
+      # This can also be set per Schema.
+      config.hard_cache_operations = false
+
+      # When set with the size of a pool of threads, sources built by a schema
+      # will first load what they need from the database concurrently, like
+      # the columns of the models, and only then be built one by one. Make
+      # sure that the database pool has enough connections for it. This can
+      # also be set per Schema.
+      config.concurrent_source_build = false
+
+      # When enabled, the duration of the resolvers of the fields is collected
+      # as a histogram per field, which is added as +resolvers+ to the payload
+      # of each +resolve.graphql+ event. This can also be set per Schema.
+      config.resolver_timings = false
+
+      # The fraction of executions, from 0.0 to 1.0, that have the resolvers
+      # of their fields traced in the same format as Apollo Tracing. Each trace
+      # is sent through the +trace.graphql+ event and, unless disabled by
+      # +tracing_in_extensions+, added as +tracing+ to the extensions of the
+      # response. Both can also be set per Schema.
+      config.tracing_sample_rate = 0
+      config.tracing_in_extensions = true
+
+      # When enabled, controllers and channels hand variables given as a JSON
+      # string to the request as they are. They are then decoded natively and
+      # coerced against the definitions of the variables of each operation,
+      # which means that +gql_variables+ may return a string.
+      config.decode_variables_natively = false
+
       # A list of all possible ruby-to-graphql compatible sources.
       config.sources = [
         'Rails::GraphQL::Source::ActiveRecordSource',
@@ -175,7 +221,7 @@ module Rails
         object:    {},
         union:     {},
         directive: {
-          # cached:    "#{__dir__}/directive/cached_directive",
+          cached:    "#{__dir__}/directive/cached_directive",
         },
       }
 
@@ -4,30 +4,70 @@ module Rails
   module GraphQL
     # = GraphQL Cached Directive
     #
-    # Indicates that the request has hard cached operations that need to be
-    # collected
+    # Allow the result of a field to be cached already serialized, so that the
+    # value can be added straight to the response. The key of the cache is based
+    # on the position of the field in the document, the parent object, the
+    # arguments, and an optional +scope+, which is the name of a value in the
+    # context of the request, like +current_user+.
+    #
+    # The parent object and the scope value must respond to
+    # +cache_key_with_version+ or +cache_key+, otherwise the result is not
+    # cached. Only results produced without errors are cached.
     class Directive::CachedDirective < Directive
-      placed_on :query
+      placed_on :field, :field_definition
+
+      desc 'Allow the result of the field to be cached.'
 
-      desc 'Indicates that there are hard cached operations.'
+      argument :ttl, :int, desc: <<~DESC
+        The amount of seconds that the result should be kept in the cache.
+      DESC
 
-      argument :id, :ID, null: false, desc: <<~DESC
-        The unique identifier of the cached operation.
+      argument :scope, :string, desc: <<~DESC
+        The name of a value in the context that separates the cached results.
       DESC
 
-      on(:attach) do |source, request|
-        source.data.selection = nil
-        # TODO: Add the request name back
-        # source.instance_variable_set(:@name, 'here')
+      # Add the cached result of the +field+ to the response, or run the given
+      # block and save the result written by it
+      def fetch_result(field)
+        return yield if (key = cache_key_for(field)).nil?
 
-        # TODO: Add the arguments and variables
-        field = request.build(Request::Component::Field, source, nil, { name: 'a', alias: 'b' })
-        field.assing_to(ApplicationSchema[:query][:a])
-        field.check_authorization!
+        schema, request, response = field.schema, field.request, field.response
+        cached = schema.read_from_cache(key)
+        return response.add(field.response_key, cached) unless cached.nil?
 
-        source.instance_variable_set(:@selection, { 'b' => field })
-        # puts source.inspect
+        errors = request.errors.size
+        value = response.capture(field.response_key) { yield }
+        return if value.nil? || request.errors.size > errors
+
+        schema.write_on_cache(key, value, expires_in: args.ttl)
       end
+
+      private
+
+        # Build the key of the result for the given +field+ component, or
+        # return nil when the parent object can not be identified
+        def cache_key_for(field)
+          request = field.request
+          parent = request.strategy.context&.current_value
+          parent_key = identity_of(parent) unless parent.nil?
+          return if !parent.nil? && parent_key.nil?
+
+          unless args.scope.nil? || (scope = request.context[args.scope]).nil?
+            return if (scope = identity_of(scope)).nil?
+          end
+
+          node = field.node
+          list = [field.response.class, request.document_digest, node.begin_line, node.begin_column]
+          list.push(parent_key, field.arguments.to_h, scope)
+
+          ActiveSupport::Cache.expand_cache_key(list, 'result')
+        end
+
+        # Get a value that identifies the given +object+
+        def identity_of(object)
+          object.try(:cache_key_with_version) || object.try(:cache_key) ||
+            (object.is_a?(::String) || object.is_a?(::Numeric) ? object : nil)
+        end
     end
   end
 end
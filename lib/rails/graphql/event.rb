@@ -96,26 +96,30 @@ module Rails
       # Fetch all the events from the object, get only the ones that are from
       # the same name as the instance of this class and call +trigger+. It runs
       # in reverse order, so first in first out. Since events can sometimes be
-      # cached, using +events+ avoid calculating the +all_events+
+      # cached, using +events+ avoid calculating the +all_events+. The list is
+      # walked using a cursor, so that +call_next+ can move it forward
       def trigger_object(object, events = nil)
         @items ||= nil
+        @cursor ||= nil
         @object ||= nil
         @last_result ||= nil
 
-        old_items, old_object, old_result, @object = @items, @object, @last_result, object
+        old_items, old_cursor, old_object, old_result, @object =
+          @items, @cursor, @object, @last_result, object
 
         catchable(:object) do
           events ||= object.all_events.try(:[], event_name)
           stop if events.blank?
 
-          @items = @reverse ? events.reverse_each : events.each
-          call_next while @items.peek
-        rescue StopIteration
+          @items, @cursor = events, -1
+          call_next while @cursor < @items.size - 1
+
           # TODO: Make sure that the +@collect+ works
-          return @last_result
+          @last_result
         end
       ensure
         @items = old_items
+        @cursor = old_cursor
         @object = old_object
         @last_result = old_result
       end
@@ -132,11 +136,11 @@ module Rails
         throw(layer || @layers.first, *result)
       end
 
-      # Call the next item on the queue and return its result
+      # Call the next item on the queue and return its result. It does not do
+      # anything when missing next/super
       def call_next
-        trigger(@items.next)
-      rescue StopIteration
-        # Do not do anything when missing next/super
+        return if @items.nil? || (@cursor += 1) >= @items.size
+        trigger(@items[@reverse ? -@cursor - 1 : @cursor])
       end
 
       protected
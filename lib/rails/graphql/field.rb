@@ -127,6 +127,7 @@ module Rails
         super
 
         @owner = nil
+        @event_chain = nil
       end
 
       # Apply a controlled set of changes to the field
@@ -147,6 +148,28 @@ module Rails
         self
       end
 
+      # Merge and freeze the events and the listeners of the field, which are
+      # kept for as long as the given revision of the type map snapshot is
+      # valid. This is only called while the snapshot is built
+      def compile_event_chain!(revision)
+        events = all_events.presence&.transform_values { |list| list.dup.freeze }
+        listeners = all_listeners.presence&.dup
+        @event_chain = [events&.freeze, listeners&.freeze, revision].freeze
+      end
+
+      # Get the events of the field already merged and frozen by the snapshot
+      # of the type map. Without a valid one, the events are merged as usual
+      def compiled_events
+        chain = compiled_event_chain
+        chain.nil? ? all_events.presence : chain[0]
+      end
+
+      # Same as +compiled_events+, but for the listeners
+      def compiled_listeners
+        chain = compiled_event_chain
+        chain.nil? ? all_listeners.presence : chain[1]
+      end
+
       # Return the owner as the single item of the list
       def all_owners
         [owner]
@@ -324,6 +347,14 @@ module Rails
           proxied_owner.is_a?(Module) && proxied_owner <= Alternative::Query
         end
 
+        # Get the chain compiled by the snapshot of the type map, but only if
+        # it is still valid. It is never filled from here, so requests don't
+        # pay for it nor race each other
+        def compiled_event_chain
+          return unless defined?(@event_chain) && !(chain = @event_chain).nil?
+          chain if chain.last == GraphQL.type_map.snapshot_revision
+        end
+
         # Show the name of the owner of the object for inspection
         def inspect_owner
           owner.is_a?(Module) ? owner.name : owner.class.name
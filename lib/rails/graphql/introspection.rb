@@ -4,6 +4,50 @@ module Rails
   module GraphQL
     # Module related to some methods regarding the introspection of a schema
     module Introspection
+      # The maximum number of different introspection responses cached per
+      # schema, which prevents the cache from growing indefinitely
+      CACHE_SIZE = 16
+
+      # Synchronizes the access to the introspection cache of all the schemas
+      CACHE_LOCK = Mutex.new
+
+      # The standard introspection query, used to warm up the cache
+      STANDARD_QUERY = <<~GQL.freeze
+        query IntrospectionQuery {
+          __schema {
+            queryType { name }
+            mutationType { name }
+            subscriptionType { name }
+            types { ...FullType }
+            directives { name description locations args { ...InputValue } isRepeatable }
+          }
+        }
+
+        fragment FullType on __Type {
+          kind name description specifiedByURL
+          fields(includeDeprecated: true) {
+            name description args { ...InputValue } type { ...TypeRef }
+            isDeprecated deprecationReason
+          }
+          inputFields { ...InputValue }
+          interfaces { ...TypeRef }
+          enumValues(includeDeprecated: true) {
+            name description isDeprecated deprecationReason
+          }
+          possibleTypes { ...TypeRef }
+        }
+
+        fragment InputValue on __InputValue {
+          name description type { ...TypeRef } defaultValue
+        }
+
+        fragment TypeRef on __Type {
+          kind name ofType { kind name ofType { kind name ofType { kind name
+          ofType { kind name ofType { kind name ofType { kind name
+          ofType { kind name } } } } } } }
+        }
+      GQL
+
       # When register is called, add introspection related elements
       def register!(*)
         super if defined? super
@@ -24,8 +68,49 @@ module Rails
         false
       end
 
+      # Get the cached response of an introspection request, which is only
+      # valid for the current version of the schema, marking it as the most
+      # recently used one
+      def cached_introspection(key)
+        CACHE_LOCK.synchronize do
+          cache = introspection_cache
+          cache[key] = cache.delete(key) if cache.key?(key)
+        end
+      end
+
+      # Save the response of an introspection request, dropping the least
+      # recently used one when the cache is full
+      def cache_introspection(key, value)
+        CACHE_LOCK.synchronize do
+          cache = introspection_cache
+          cache.delete(key)
+          cache[key] = value
+          cache.delete(cache.each_key.first) if cache.size > CACHE_SIZE
+          value
+        end
+      end
+
+      # Run the given introspection +documents+, so that their responses are
+      # cached up front, like during boot
+      def warm_introspection!(*documents, **xargs)
+        return unless introspection?
+
+        documents << STANDARD_QUERY if documents.empty?
+        documents.each { |document| Request.execute(document, **xargs, schema: self) }
+      end
+
       protected
 
+        # The storage of the introspection responses, ordered from the least
+        # to the most recently used, and reset whenever the version changes
+        def introspection_cache
+          return @introspection_cache if defined?(@introspection_version) &&
+            @introspection_version == version
+
+          @introspection_version = version
+          @introspection_cache = {}
+        end
+
         # Enable introspection fields
         def enable_introspection!
           redefine_singleton_method(:introspection?) { true }
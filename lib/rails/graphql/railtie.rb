@@ -114,9 +114,20 @@ module Rails
         end
       end
 
+      # Compile the snapshot of the type map once everything was eager loaded,
+      # so that requests can find their types without any synchronization
+      initializer 'graphql.type_map_snapshot' do |app|
+        config.after_initialize do
+          GraphQL.type_map.snapshot! if app.config.eager_load
+        end
+      end
+
       # Properly setup how GraphQL reload itself
       # TODO: Check proper support for Rails engines
       initializer 'graphql.reloader', before: :load_config_initializers do |app|
+        # Specialized request classes may include reloaded class extensions
+        app.reloader.before_class_unload { Request::SPECIALIZED_CLASSES.clear }
+
         next unless (path = app.root.join('app', 'graphql')).exist?
 
         children = config.graphql.paths.to_a.join(',')
@@ -110,13 +110,16 @@ module Rails
           { action: (data['action'] || :receive).to_sym }
         end
 
-        # Get the GraphQL variables for a request
+        # Get the GraphQL variables for a request. A JSON string is only kept
+        # as it is when +decode_variables_natively+ is enabled
         def gql_variables(data, variables = nil)
           variables ||= data['variables']
 
           case variables
           when ::ActionController::Parameters then variables.permit!.to_h
-          when String then variables.present? ? JSON.parse(variables) : {}
+          when String
+            return variables if GraphQL.config.decode_variables_natively
+            variables.present? ? JSON.parse(variables) : {}
           when Hash   then variables
           else {}
           end
@@ -27,7 +27,7 @@ module Rails
 
         payload = event.payload
         cached = '[CACHE]' if payload[:cached]
-        doc = payload[:document]&.gsub(REMOVE_COMMENTS, '')&.squish
+        doc = minify(payload[:document])
 
         desc = +"#{header(event, cached)}  #{doc}"
         desc << debug_variables(payload[:variables]) unless payload[:variables].blank?
@@ -39,7 +39,7 @@ module Rails
         return unless logger.debug?
 
         payload = event.payload
-        doc = payload[:document].gsub(REMOVE_COMMENTS, '').squish
+        doc = minify(payload[:document])
 
         helper = ActiveSupport::NumberHelper::NumberToHumanSizeConverter
         total = helper.convert(payload[:total], EMPTY_HASH)
@@ -51,7 +51,7 @@ module Rails
         return unless logger.debug?
 
         payload = event.payload
-        doc = payload[:document].gsub(REMOVE_COMMENTS, '').squish
+        doc = minify(payload[:document])
         valid = payload[:result] ? color('YES', GREEN) : color('NO', RED)
 
         debug(+"#{header(event, 'Valid?')} #{valid}  #{doc}")
@@ -78,6 +78,12 @@ module Rails
           end
         end
 
+        if type == :broadcasted
+          fan_out, executions = event.payload.values_at(:fan_out, :executions)
+          desc << +": #{fan_out} #{'subscription'.pluralize(fan_out)}"
+          desc << +" with #{executions} #{'execution'.pluralize(executions)}"
+        end
+
         info(desc)
       end
 
@@ -102,6 +108,16 @@ module Rails
           color(parts.compact.join(' '), MAGENTA, style)
         end
 
+        # Show the document without comments and ignorable characters, even
+        # when it is not a valid one
+        def minify(document)
+          return if document.nil?
+
+          ::GQLParser.minify(document)
+        rescue ::GQLParser::ParserError
+          document.gsub(REMOVE_COMMENTS, '').squish
+        end
+
         def debug_variables(vars)
           vars = JSON.pretty_generate(parameter_filter.filter(vars))
           +'  ' << '(' << vars.squish << ')'
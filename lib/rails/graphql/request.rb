@@ -11,7 +11,8 @@ module Rails
     #
     # ==== Options
     #
-    # * <tt>:args</tt> - The arguments of the request, same as variables
+    # * <tt>:args</tt> - The arguments of the request, same as variables, which
+    #   can also be a JSON string to be decoded natively
     # * <tt>:as</tt> - The format of the output of the request, supports both
     #   +:hash+ and +:string+ (defaults to :string)
     # * <tt>:context</tt> - The context of the request, which can be accessed in
@@ -58,12 +59,29 @@ module Rails
         autoload :Errors
         autoload :Event
         autoload :PreparedData
+        autoload :ResolverTimings
         autoload :Strategy
         autoload :Subscription
+        autoload :Tracer
       end
 
-      attr_reader :args, :origin, :errors, :fragments, :operations, :response, :schema,
-        :stack, :strategy, :document, :operation_name, :subscriptions
+      # The thread key that holds the current branch of a request, used when
+      # operations are executed concurrently
+      BRANCH_KEY = :_rails_graphql_request_branch
+
+      # The root fields of the documents that can have their responses cached
+      # as introspection
+      INTROSPECTION_ROOTS = %w[__schema __type].freeze
+
+      # Stores the subclasses that include class extensions, indexed by the
+      # class and the list of extensions
+      SPECIALIZED_CLASSES = Concurrent::Map.new
+
+      # Holds the objects that change per branch of the execution
+      Branch = Struct.new(:request, :strategy, :response, :stack)
+
+      attr_reader :args, :origin, :errors, :fragments, :operations, :schema,
+        :document, :operation_name, :subscriptions, :tracer
 
       alias arguments args
       alias controller origin
@@ -93,6 +111,11 @@ module Rails
           new(schema, namespace: namespace).valid?(*args, **xargs)
         end
 
+        # Check if the current thread is running a branch of any request
+        def branched?
+          !Thread.current[BRANCH_KEY].nil?
+        end
+
         # Allow accessing component-based objects through the request
         def const_defined?(name, *)
           Component.const_defined?(name, false) || super
@@ -117,6 +140,33 @@ module Rails
         defined?(@subscriptions) && @subscriptions.any?
       end
 
+      # Get the strategy of the request, or the one of the current branch
+      def strategy
+        branch&.strategy || @strategy
+      end
+
+      # Get the response collector, or the one of the current branch
+      def response
+        branch&.response || @response
+      end
+
+      # Get the execution stack, or the one of the current branch
+      def stack
+        branch&.stack || @stack
+      end
+
+      # Execute the given block using a different +strategy+ and +response+,
+      # which allows operations to be resolved by other threads while sharing
+      # the same request
+      def branched(strategy, response)
+        @branched = true
+        previous = Thread.current[BRANCH_KEY]
+        Thread.current[BRANCH_KEY] = Branch.new(self, strategy, response, @stack.dup)
+        yield
+      ensure
+        Thread.current[BRANCH_KEY] = previous
+      end
+
       # Get the context of the request
       def context
         @context ||= OpenStruct.new.freeze
@@ -142,14 +192,15 @@ module Rails
         prepared_data = xargs.delete(:data_for)
         reset!(**xargs)
 
+        @tracer = Tracer.new(self) if sample_tracing?
         @response = initialize_response(output, formatter)
         import_prepared_data(prepared_data)
         execute!(document, cache)
 
-        response.public_send(formatter)
+        serialize_response(formatter)
       rescue StaticResponse
         # TODO: Maybe change this to a throw/catch instead
-        response.public_send(formatter)
+        serialize_response(formatter)
       end
 
       alias perform execute
@@ -231,7 +282,7 @@ module Rails
           args: @args,
           source: stack.first,
           request: self,
-          response: @response,
+          response: response,
           document: @document,
         )).freeze
       end
@@ -276,10 +327,17 @@ module Rails
       # Add the given +object+ into the execution +stack+ and execute the given
       # +block+ making sure to rescue exceptions using the +rescue_with_handler+
       def stacked(object, &block)
-        stack.unshift(object)
+        (current = stack).unshift(object)
         block.call
       ensure
-        stack.shift
+        current.shift
+      end
+
+      # The name of the type that owns the given +field+, which is the type of
+      # the operation for fields of the schema
+      def owner_name_of(field)
+        return field.owner.gql_name unless field.owner.is_a?(Helpers::WithSchemaFields)
+        schema.type_name_for(field.schema_type)
       end
 
       # Convert the current stack into a error path ignoring the schema
@@ -293,24 +351,27 @@ module Rails
       # extended behaviors for all the objects created through the request
       def extend(*modules)
         import_class_extensions(*modules)
-        request_ext = class_extensions[self.class]
-        super(request_ext) if request_ext && !is_a?(request_ext)
+        @specialized_classes = nil
+
+        request_ext = class_extensions[self.class]&.reject { |mod| is_a?(mod) }
+        super(*request_ext.reverse) if request_ext.present?
       end
 
       # This initiates a new object which is aware of class extensions
       def build(klass, *args, &block)
-        ext_module = class_extensions[klass]
-        obj = klass.new(*args, &block)
-        obj.extend(ext_module) if ext_module
-        obj
+        specialized_class(klass).new(*args, &block)
       end
 
       # This allocates a new object which is aware of class extensions
       def build_from_cache(klass)
-        ext_module = class_extensions[klass]
-        obj = klass.allocate
-        obj.extend(ext_module) if ext_module
-        obj
+        specialized_class(klass).allocate
+      end
+
+      # Get the class of an object built by the request, ignoring the
+      # specialized one created because of class extensions
+      def unspecialized_class_of(obj)
+        klass = obj.class
+        klass.respond_to?(:specialized_from) ? klass.specialized_from : klass
       end
 
       # A shared way to cache information across the execution of an request
@@ -324,11 +385,66 @@ module Rails
         (source = cache(key)).key?(sub_key) ? source[sub_key] : source[sub_key] = yield
       end
 
+      # Get a digest of the canonical form of the document being executed,
+      # which is computed only once per request
+      def document_digest
+        nested_cache(:document, :digest) do
+          source = @document.is_a?(::Array) ? ::GQLParser.print_execution(@document) : @document
+          Digest::SHA256.hexdigest(source.to_s)
+        end
+      end
+
       # Show if the current cached operation is still valid
       def valid_cache?
         defined?(@valid_cache) && @valid_cache
       end
 
+      # Check if the organized request can be hard cached
+      def hard_cache?
+        defined?(@hard_cache) && @hard_cache.present?
+      end
+
+      # Mark that the organized request depends on the values of variables,
+      # which prevents it from being hard cached
+      def variable_dependent!
+        @variable_dependent = true
+      end
+
+      # Mark that one of the components of the request was invalidated, which
+      # also prevents it from being hard cached
+      def invalidated!
+        @invalidated = true
+      end
+
+      # Get the index of the slot that holds the value of the given variable
+      # +name+, which is shared by all the operations of the request
+      def variable_slot(name)
+        names = variable_slot_names
+        names.index(name) || (names << name).size - 1
+      end
+
+      # Get the values of the variables of an operation with the given
+      # definitions. The ones given as a JSON string are decoded again,
+      # coerced against the definitions, which raises any problem found
+      def args_for(definitions)
+        return args if @raw_args.nil? || definitions.blank?
+
+        definitions = definitions.each_with_object({}) do |(name, type), result|
+          type_name, dimensions, nullability = type
+          result[name.to_s] = [type_name.to_s, dimensions, nullability]
+        end
+
+        values = ::GQLParser.decode_variables(@raw_args, definitions)
+        build_ostruct(values.transform_keys { |key| key.to_s.camelize(:lower) }).freeze
+      rescue ::GQLParser::VariablesError => err
+        raise ArgumentsError, err.errors.join(', ')
+      end
+
+      # The names of the variables in the order of their slots
+      def variable_slot_names
+        @variable_slot_names ||= []
+      end
+
       # Write the request into the cache so it can run again faster
       def write_cache_request(hash, data = cache_dump)
         schema.write_on_cache(hash, Marshal.dump(data))
@@ -386,6 +502,24 @@ module Rails
           @class_extensions ||= {}
         end
 
+        # Get the subclass of +klass+ that includes all its class extensions.
+        # Subclasses are shared by all the requests with the same extensions,
+        # instead of extending each object built, which would create one
+        # singleton class per object
+        def specialized_class(klass)
+          klass = klass.specialized_from if klass.respond_to?(:specialized_from)
+          return klass if (list = class_extensions[klass]).nil?
+
+          (@specialized_classes ||= {})[klass] ||=
+            SPECIALIZED_CLASSES.compute_if_absent([klass, *list]) do
+              Class.new(klass) do
+                list.each { |mod| include(mod) }
+                define_singleton_method(:specialized_from) { klass }
+                define_singleton_method(:name) { klass.name }
+              end
+            end
+        end
+
         # Stores all the prepared data, but only when it is needed
         def prepared_data
           @prepared_data ||= {}
@@ -393,17 +527,25 @@ module Rails
 
       private
 
+        # Find the branch of the request running on the current thread
+        def branch
+          return unless defined?(@branched) && @branched
+
+          current = Thread.current[BRANCH_KEY]
+          current if current&.request.equal?(self)
+        end
+
         # Reset principal variables and set the given +args+
         def reset!(args: nil, variables: {}, operation_name: nil, origin: nil)
           @arg_names = {}
+          args ||= variables || {}
 
-          @args = (args || variables || {}).transform_keys do |key|
-            key.to_s.camelize(:lower).tap do |sanitized_key|
-              @arg_names[sanitized_key] = key
-            end
-          end
+          # Variables given as a JSON string are decoded natively once the
+          # execution starts, and each operation coerces them again against
+          # its own definitions
+          @raw_args = args.is_a?(::String) ? args.presence : nil
+          assign_args(args.is_a?(::String) ? EMPTY_HASH : args)
 
-          @args = build_ostruct(@args).freeze
           @errors = Request::Errors.new(self)
           @operation_name = operation_name
           @origin = origin
@@ -413,22 +555,62 @@ module Rails
           @log_extra  = {}
           @subscriptions = {}
           @used_variables = Set.new
+          @variable_slot_names = nil
 
           @strategy = nil
+          @branched = false
+          @hard_cache = nil
+          @introspection = nil
+          @variable_dependent = false
+          @invalidated = false
+          @tracer = nil
           schema.validate
         end
 
+        # Check if the request should be traced, based on the fraction of the
+        # requests that are sampled
+        def sample_tracing?
+          rate = schema.config.tracing_sample_rate
+          rate.present? && rate > 0 && (rate >= 1 || Random.rand < rate)
+        end
+
+        # Report the trace of the request and add it to the extensions
+        def finish_tracing
+          trace, @tracer = @tracer.to_h, nil
+          ActiveSupport::Notifications.instrument('trace.graphql', trace: trace)
+          extensions[:tracing] = trace if schema.config.tracing_in_extensions
+        end
+
+        # Sanitize the name of the given arguments and set them as the args
+        def assign_args(values)
+          @args = values.transform_keys do |key|
+            key.to_s.camelize(:lower).tap do |sanitized_key|
+              @arg_names[sanitized_key] = key
+            end
+          end
+
+          @args = build_ostruct(@args).freeze
+        end
+
         # This executes the whole process capturing any exceptions and handling
         # them as defined by the schema
         def execute!(document, cache = nil)
+          @hard_cache = hard_cache_key(document) if cache.nil?
+
           log_execution(document, cache) do
             @document = initialize_document(document, cache)
-            @document.is_a?(String) ? read_cache_request : run_document
+            @introspection = introspection_key(document) if cache.nil?
+            next if add_cached_introspection
+
+            decode_raw_args unless @raw_args.nil?
+            @document.is_a?(String) ? read_cache_request : with_introspection_cache { run_document }
           end
         ensure
           report_unused_variables
           write_cache_request(cache) if cache.present? && !valid_cache?
+          write_cache_request(@hard_cache) if write_hard_cache?
           @response.try(:append_errors, errors)
+          finish_tracing unless @tracer.nil?
 
           if defined?(@extensions)
             @response.try(:append_extensions, @extensions)
@@ -486,10 +668,10 @@ module Rails
                 end
               end
 
-              # Create the shared module and include the class extension
+              # Add the class extension to the list of the class
               next unless klass&.is_a?(Class)
-              class_extensions[klass] ||= Module.new
-              class_extensions[klass].include(const)
+              list = class_extensions[klass] ||= []
+              list << const unless list.include?(const)
             end
           end
         end
@@ -520,10 +702,90 @@ module Rails
           )
         end
 
+        # Get the key of the organized version of the given +document+ when
+        # hard cache is enabled
+        def hard_cache_key(document)
+          return unless schema.config.hard_cache_operations && document.is_a?(::String)
+          +"hard/#{schema.version}/#{Digest::SHA256.hexdigest(minify(document))}"
+        end
+
+        # Get the canonical form of the given +document+, so that the same
+        # document written differently shares the same cache keys. An invalid
+        # one is kept as is, since the parser is the one reporting about it
+        def minify(document)
+          ::GQLParser.minify(document)
+        rescue ::GQLParser::ParserError
+          document
+        end
+
+        # Only write the hard cache when the request was organized by the
+        # proper strategy, finished without errors or invalid components, and
+        # does not depend on the values of variables
+        def write_hard_cache?
+          hard_cache? && !valid_cache? && !@variable_dependent && !@invalidated &&
+            errors.empty? && @operations.present? && @strategy.is_a?(Strategy::CachedStrategy)
+        end
+
+        # Get the key of the response of a possible introspection +document+,
+        # which must not have variables
+        def introspection_key(document)
+          return unless schema.introspection? && document.is_a?(::String)
+          return unless @arg_names.empty? && @raw_args.nil? && response.respond_to?(:capture)
+          return unless introspection_document?
+
+          [response.class.name, @operation_name, Digest::SHA256.hexdigest(minify(document))]
+        end
+
+        # Check if the parsed document only has queries without variables
+        # whose root selections are all plain introspection entry points
+        def introspection_document?
+          operations = @document.try(:first)
+          return false unless operations.is_a?(::Array) && operations.any?
+
+          operations.all? do |node|
+            node.try(:type) == :query && node[2].nil? && node[3].nil? && node[4].present? &&
+              node[4].all? do |item|
+                item.type == :field && item[3].nil? && INTROSPECTION_ROOTS.include?(item[0].to_s)
+              end
+          end
+        end
+
+        # Add the cached introspection response, if there is one
+        def add_cached_introspection
+          return if @introspection.nil?
+          return if (value = schema.cached_introspection(@introspection)).nil?
+
+          @log_extra[:introspection] = true
+          response.add('data', value.is_a?(::String) ? value : value.deep_dup)
+        end
+
+        # Save the response of the request when it only contains introspection
+        # fields and it has finished without errors
+        def with_introspection_cache(&block)
+          return block.call if @introspection.nil?
+
+          value = response.capture('data', &block)
+          return if value.nil? || !errors.empty? || !introspection_only?
+
+          schema.cache_introspection(@introspection, value)
+        end
+
+        # Check if all the operations only requested introspection fields
+        def introspection_only?
+          operations.each_value.all? do |op|
+            op.query? && op.selection&.each_value&.all? do |item|
+              item.is_a?(Component::Typename) ||
+                (item.is_a?(Component::Field) && item.name.to_s.start_with?('__'))
+            end
+          end
+        end
+
         # When document is empty and the hash has been provided, then
         def initialize_document(document, cache = nil)
-          if document.present?
-            ::GQLParser.parse_execution(document)
+          if hard_cache? && schema.cached?(@hard_cache)
+            schema.read_from_cache(@hard_cache)
+          elsif document.present?
+            parse_document(document)
           elsif cache.nil?
             raise ::ArgumentError, +'Unable to execute an empty document.'
           elsif schema.cached?(cache)
@@ -538,6 +800,34 @@ module Rails
           nil
         end
 
+        # Parse the given +document+ with the parser of the current thread,
+        # reporting the stats of the parse
+        def parse_document(document)
+          ActiveSupport::Notifications.instrument('parse.graphql', document: document) do |payload|
+            parser = ::GQLParser::Parser.current
+            parser.parse_execution(document).tap { payload[:stats] = parser.stats }
+          end
+        end
+
+        # Turn the response into the requested format
+        def serialize_response(formatter)
+          ActiveSupport::Notifications.instrument('serialize.graphql', format: formatter) do
+            response.public_send(formatter)
+          end
+        end
+
+        # Decode the variables provided as a JSON string natively, without
+        # coercing them, so they are available as the args of the request.
+        # An invalid JSON prevents the document from being executed, just like
+        # an invalid document
+        def decode_raw_args
+          assign_args(::GQLParser.decode_variables(@raw_args))
+        rescue ::GQLParser::ParserError => err
+          @raw_args = nil
+          errors.add(err.message)
+          @document = nil
+        end
+
         # Initialize the class that responsible for storing the response
         def initialize_response(as_format, to)
           raise ::ArgumentError, (+<<~MSG).squish if to.nil?
@@ -11,7 +11,8 @@ module Rails
       #
       # They lazy variable-based value is used for fragments, so that they can
       # be organized only once and have their variables changed accordingly to
-      # the spread and operation.
+      # the spread and operation. Fields read such values from the slots of
+      # variables of the operation instead, so they are not delegated.
       class Arguments < OpenStruct
         THREAD_KEY = :_rails_graphql_operation
 
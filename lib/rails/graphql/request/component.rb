@@ -58,8 +58,10 @@ module Rails
           invalid? || skipped?
         end
 
-        # Mark the component as invalid
+        # Mark the component as invalid, which also prevents the request from
+        # being hard cached
         def invalidate!(type = true)
+          request.invalidated!
           @invalid = type
         end
 
@@ -78,6 +80,13 @@ module Rails
           @node.hash
         end
 
+        # The frozen name of the component in the response. The same object is
+        # used for every row written, so collectors can store how it encodes
+        def response_key
+          return @response_key if defined?(@response_key)
+          @response_key = (key = try(:gql_name)).nil? ? nil : -key.to_s
+        end
+
         # Build the cache object
         def cache_dump
           hash = { node: @node }
@@ -18,7 +18,24 @@ module Rails
         delegate :method_name, :resolver, :performer, :type_klass, :leaf_type?,
           :dynamic_resolver?, :mutation?, to: :field
 
-        attr_reader :name, :alias_name, :parent, :field, :arguments, :current_object
+        attr_reader :name, :alias_name, :parent, :field, :current_object, :node
+
+        # Arguments bound to variables inside fragments have their values
+        # collected once per operation, straight from the slots of its
+        # variables, instead of being looked up on every read
+        def arguments
+          return @arguments unless defined?(@variable_slots)
+          return @arguments if (op = Arguments.operation).nil?
+          return @slot_arguments if op.equal?(@slot_operation)
+
+          args = @arguments.to_h
+          slots = op.variable_slots
+          @variable_slots.each { |name, idx| args[name] = slots[idx] }
+
+          @slot_arguments = request.build(Request::Arguments, args).freeze
+          @slot_operation = op
+          @slot_arguments
+        end
 
         alias args arguments
 
@@ -35,13 +52,13 @@ module Rails
         # definition field events, both from itself and its directives events
         def all_listeners
           request.nested_cache(:listeners, field) do
-            if !field.listeners?
+            if (compiled = field.compiled_listeners).nil?
               directive_listeners
             elsif !directives?
-              field.all_listeners
+              compiled
             else
               local = directive_listeners
-              local.empty? ? field.all_listeners : field.all_listeners + local
+              local.empty? ? compiled : compiled + local
             end
           end
         end
@@ -50,12 +67,12 @@ module Rails
         # definition field events, both from itself and its directives events
         def all_events
           request.nested_cache(:events, field) do
-            if !field.events?
+            if (compiled = field.compiled_events).nil?
               directive_events
             elsif !directives?
-              field.all_events
+              compiled
             else
-              Helpers.merge_hash_array(field.all_events, directive_events)
+              Helpers.merge_hash_array(compiled, directive_events)
             end
           end
         end
@@ -110,6 +127,23 @@ module Rails
           true
         end
 
+        # Check if the resolver of the field can be called before the field is
+        # actually written to the response. Mutation fields are always serial,
+        # and fields with a result cache may not need to be resolved at all
+        def resolve_ahead?
+          !invalid? && !skipped? && !mutation? && dynamic_resolver? && result_cache.nil?
+        end
+
+        # Find the directive that caches the result of the field, if any
+        def result_cache
+          return @result_cache if defined?(@result_cache)
+
+          @result_cache = directives&.find { |item| item.respond_to?(:fetch_result) }
+          @result_cache ||= request.nested_cache(:result_cache, field) do
+            field.all_directives&.find { |item| item.respond_to?(:fetch_result) }
+          end
+        end
+
         # Check if all the sub fields are broadcastable
         # TODO: Maybe check for interfaces and if all types allow broadcast
         def broadcastable?
@@ -136,7 +170,7 @@ module Rails
           request.exception_to_error(error, self) if error.present?
 
           validate_output!(nil)
-          response.safe_add(gql_name, nil)
+          response.safe_add(response_key, nil)
         rescue InvalidValueError
           raise unless entry_point?
         end
@@ -187,6 +221,29 @@ module Rails
             end
           end
 
+          # Rewrite the references to variables into slots, but only when the
+          # variables are lazy, which means the field belongs to a fragment
+          def parse_arguments(*)
+            super
+            bind_variable_slots
+          end
+
+          # Same as above, but for arguments recovered from the cache
+          def load_arguments(*)
+            super
+            bind_variable_slots
+          end
+
+          # Map the name of each argument bound to a variable to the index of
+          # the slot where its value will be
+          def bind_variable_slots
+            return unless defined?(@variable_refs) && variables.equal?(Arguments.lazy)
+
+            @variable_slots = @variable_refs.map do |name, var_name|
+              [name, request.variable_slot(var_name)].freeze
+            end.freeze
+          end
+
           # Perform the prepare step
           def prepare_then(&block)
             super { strategy.prepare(self, &block) }
@@ -195,12 +252,21 @@ module Rails
           # Perform the resolve step
           def resolve_then(&block)
             stacked do
-              send((field.array? ? :resolve_many : :resolve_one), &block)
+              with_result_cache do
+                send((field.array? ? :resolve_many : :resolve_one), &block)
+              end
             rescue StandardError => error
               resolve_invalid(error)
             end
           end
 
+          # When there is a directive that caches the result of the field, let
+          # it decide between adding the cached value or resolving it
+          def with_result_cache(&block)
+            directive = result_cache
+            directive.nil? ? block.call : directive.fetch_result(self, &block)
+          end
+
           # Don't stack over response when it's processing as array
           def stacked_selection?
             !field.array?
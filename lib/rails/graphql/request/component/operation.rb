@@ -98,6 +98,16 @@ module Rails
           response.safe_add(name, nil) if stacked_selection?
         end
 
+        # Get the values of the variables placed in the slots assigned by the
+        # request, so that arguments bound to them can be read by index
+        def variable_slots
+          names = request.variable_slot_names
+          slots = @variable_slots if defined?(@variable_slots)
+          return slots if !slots.nil? && slots.size == names.size
+
+          @variable_slots = names.map { |name| variables[name] }.freeze
+        end
+
         # Stores all the used variables to report not used ones
         def used_variables
           @used_variables ||= Set.new
@@ -124,13 +134,25 @@ module Rails
 
         # Build the cache object
         def cache_dump
-          super.merge(type: self.class)
+          super.merge(type: request.unspecialized_class_of(self))
         end
 
         # Organize from cache data
         def cache_load(data)
           @name = data[:node][1]
 
+          # Variables must be available before the selection is loaded, and
+          # the operation becomes invalid when their values are not
+          begin
+            load_arguments(data)
+          rescue ArgumentsError => error
+            @variables = EMPTY_HASH
+            invalidate!
+            report_exception(ArgumentsError.new((+<<~MSG).squish))
+              Invalid arguments for #{log_source}: #{error.message}.
+            MSG
+          end
+
           super
         end
 
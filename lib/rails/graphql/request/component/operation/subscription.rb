@@ -157,7 +157,7 @@ module Rails
 
               # Return the cache result
               {
-                strategy: { class: request.strategy.class },
+                strategy: { class: request.unspecialized_class_of(request.strategy) },
                 operation_name: request.operation_name,
                 type_map_version: request.schema.version,
                 document: [[@node], frag_nodes.presence],
@@ -34,9 +34,6 @@ module Rails
           super(name, source, **data)
         end
 
-        # TODO: Implement a faster way to check if if the event is from the
-        # same source by separating exclusive events beforehand
-
         # If the source is a field, than also compare to the actual field
         def same_source?(other)
           super || (source.try(:kind) == :field && source.field == other)
@@ -13,7 +13,7 @@ module Rails
           return super unless defined?(@selection)
 
           selection = @selection.transform_values do |field|
-            field.cache_dump.merge(type: field.class)
+            field.cache_dump.merge(type: request.unspecialized_class_of(field))
           end
 
           super.merge(selection: selection)
@@ -92,8 +92,17 @@ module Rails
             items = items.each_with_object(object) unless object.nil?
             iterator = object.nil? ? :resolve! : :resolve_with!
 
-            return items.each(&iterator) unless stacked_selection?
-            response.with_stack(gql_name) { items.each(&iterator) }
+            return resolve_items(items, iterator, object) unless stacked_selection?
+            response.with_stack(response_key, size: selection.size) do
+              resolve_items(items, iterator, object)
+            end
+          end
+
+          # Resolve all the given +items+, allowing the strategy to resolve
+          # fields ahead of time when the +object+ is known
+          def resolve_items(items, iterator, object)
+            return items.each(&iterator) unless object.nil?
+            strategy.resolve_ahead(selection) { items.each(&iterator) }
           end
 
         private
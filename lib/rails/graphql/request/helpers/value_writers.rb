@@ -50,7 +50,8 @@ module Rails
           MSG
 
           @writing_array = true
-          response.with_stack(gql_name, array: true, plain: leaf_type?) do
+          size = value.size if value.is_a?(::Array)
+          response.with_stack(response_key, array: true, plain: leaf_type?, size: size) do
             value.each(&block)
           end
         ensure
@@ -93,10 +94,10 @@ module Rails
           # multiple times inside of an array.
           def write_leaf(value)
             validate_output!(value)
-            return response.safe_add(gql_name, nil) if value.nil?
+            return response.safe_add(response_key, nil) if value.nil?
 
             # Necessary call #itself to loose the dynamic reference
-            response.serialize(type_klass, gql_name, value.itself)
+            response.serialize(type_klass, response_key, value.itself)
           end
 
           # Trigger the plain field output validation
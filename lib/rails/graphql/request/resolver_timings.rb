@@ -0,0 +1,50 @@
+# frozen_string_literal: true
+
+module Rails
+  module GraphQL
+    class Request
+      # = GraphQL Request Resolver Timings
+      #
+      # A histogram of how long, in milliseconds, the resolvers of each field
+      # took to run. It is reported by the +resolve.graphql+ event when
+      # +config.resolver_timings+ is enabled.
+      class ResolverTimings
+        # The upper limit of each bucket of the histogram, in milliseconds
+        BUCKETS = [0.1, 0.5, 1, 5, 10, 50, 100, 500, 1000, Float::INFINITY].freeze
+
+        def initialize(request)
+          @request = request
+          @fields = {}
+        end
+
+        # Time the given block as one call of the resolver of the +field+
+        def measure(field)
+          started_at = Process.clock_gettime(Process::CLOCK_MONOTONIC, :float_millisecond)
+          yield
+        ensure
+          add(field, Process.clock_gettime(Process::CLOCK_MONOTONIC, :float_millisecond) - started_at)
+        end
+
+        # Add one call of the resolver of the +field+ that took +duration+
+        def add(field, duration)
+          entry = @fields[field] ||= { count: 0, total: 0.0, max: 0.0, buckets: Array.new(BUCKETS.size, 0) }
+          entry[:count] += 1
+          entry[:total] += duration
+          entry[:max] = duration if duration > entry[:max]
+          entry[:buckets][BUCKETS.bsearch_index { |limit| duration <= limit }] += 1
+        end
+
+        # Return everything collected so far, indexed by the name of the fields,
+        # like +User.email+, and start over
+        def flush
+          result = @fields.each_with_object({}) do |(field, entry), hash|
+            hash[+"#{@request.owner_name_of(field)}.#{field.gql_name}"] = entry
+          end
+
+          @fields = {}
+          result
+        end
+      end
+    end
+  end
+end
@@ -22,26 +22,20 @@ module Rails
               nil
             elsif is_a?(Component::Operation)
               all_to_gid(@arguments.transform_values)
+            elsif defined?(@variable_refs)
+              @arguments.to_h.except(*@variable_refs.keys)
             else
               @arguments.to_h
             end
 
-          { arguments: arguments }
+          hash = { arguments: arguments }
+          hash[:variable_refs] = @variable_refs if defined?(@variable_refs)
+          hash
         end
 
         # Organize from cache data
         def cache_load(data)
-          if (args = data[:arguments]).blank?
-              @arguments = EMPTY_HASH
-          elsif is_a?(Component::Operation)
-            @arguments = all_from_gid(args.transform_values)
-
-            unless defined?(@variables)
-              @variables = collect_arguments(self, request.args, var_access: false).freeze
-            end
-          else
-            @arguments = request.build(Request::Arguments, args).freeze
-          end
+          load_arguments(data) unless defined?(@arguments)
 
           # Always trigger the organized event
           unless unresolvable?
@@ -55,6 +49,31 @@ module Rails
 
         protected
 
+          # Recover the arguments from the cache data. Arguments that came from
+          # variables are collected again from the current ones
+          def load_arguments(data)
+            args, refs = data.values_at(:arguments, :variable_refs)
+
+            if args.blank? && refs.blank?
+              @arguments = EMPTY_HASH
+              @variables = EMPTY_HASH if kind == :operation && !defined?(@variables)
+            elsif is_a?(Component::Operation)
+              @arguments = all_from_gid(args.transform_values)
+              request.instance_variable_get(:@used_variables).merge(@arguments.keys)
+
+              unless defined?(@variables)
+                values = request.args_for(data[:node]&.[](2))
+                @variables = collect_arguments(self, values, var_access: false).freeze
+              end
+            else
+              args = args.nil? ? {} : args.dup
+              refs&.each { |name, var_name| args[name] = variables[var_name] }
+
+              @variable_refs = refs unless refs.nil?
+              @arguments = request.build(Request::Arguments, args).freeze
+            end
+          end
+
           # Normally, fields come from the +type_klass+
           def fields_source
             type_klass.fields
@@ -105,7 +124,7 @@ module Rails
               item.validate!
             end
 
-            args = collect_arguments(self, request.args, var_access: false)
+            args = collect_arguments(self, request.args_for(nodes), var_access: false)
 
             @variables = args.freeze
             @arguments.freeze
@@ -124,7 +143,10 @@ module Rails
               hash[name.to_s] = var_name.nil? ? value : var_name
             end
 
-            args = collect_arguments(self, args)
+            refs = {}
+            args = collect_arguments(self, args, refs: refs)
+
+            @variable_refs = refs.freeze if refs.any?
             @arguments = request.build(Request::Arguments, args).freeze
           rescue ArgumentsError => error
             raise ArgumentsError, (+<<~MSG).squish
@@ -135,8 +157,9 @@ module Rails
           # Build a hash that collect validated values for a set of arguments.
           # The +source+ can either be the list of arguments or an object that
           # responds to +all_arguments+. The +block+ is called when something
-          # goes wrong to collect a formatted message.
-          def collect_arguments(source, values, var_access: true, &block)
+          # goes wrong to collect a formatted message. When +refs+ is provided,
+          # it collects which arguments had their values from variables.
+          def collect_arguments(source, values, var_access: true, refs: nil, &block)
             op_vars = nil
 
             errors = []
@@ -168,6 +191,7 @@ module Rails
 
                 # Mark the variable as used and grab the value
                 operation.used_variables << var_name
+                refs.nil? ? request.variable_dependent! : refs[argument.name] = op_var.name
                 value = variables[op_var.name]
               elsif !value.nil?
                 # Only when the given value is an actual value that we check if
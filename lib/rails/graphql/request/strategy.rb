@@ -18,6 +18,13 @@ module Rails
         # Configurations for the prepare step
         PREPARE_XARGS = { object?: true, reverse?: true }.freeze
 
+        # The events instrumented for each stage of the strategy
+        STAGE_EVENTS = {
+          organize: 'organize.graphql',
+          prepare: 'prepare.graphql',
+          resolve: 'resolve.graphql',
+        }.freeze
+
         # The priority of the strategy
         class_attribute :priority, instance_accessor: false, default: 1
 
@@ -38,6 +45,7 @@ module Rails
           @request = request
           @objects_pool = {}
           @listeners = Hash.new { |h, k| h[k] = Set.new }
+          @timings = ResolverTimings.new(request) if schema.config.resolver_timings
           add_listeners_from(request)
         end
 
@@ -45,7 +53,7 @@ module Rails
         def clear
           @listeners.clear
           @objects_pool.clear
-          @stage = @context = @objects_pool = @data_pool = @listeners = nil
+          @stage = @context = @objects_pool = @data_pool = @listeners = @ahead = nil
         end
 
         # Executes the strategy in the normal mode
@@ -53,6 +61,18 @@ module Rails
           raise NotImplementedError
         end
 
+        # Build a copy of the strategy that can prepare and resolve operations
+        # independently, sharing only what was collected during organize
+        def branch
+          dup.tap do |other|
+            other.instance_variable_set(:@objects_pool, {})
+            other.instance_variable_set(:@data_pool, nil)
+            other.instance_variable_set(:@context, nil)
+            other.instance_variable_set(:@ahead, nil)
+            other.instance_variable_set(:@timings, ResolverTimings.new(request)) if @timings
+          end
+        end
+
         # Find a given +type+ and store it on request cache
         def find_type!(type)
           request.nested_cache(:types, type) { schema.find_type!(type) }
@@ -112,9 +132,12 @@ module Rails
         # Resolve a value for a given object, It uses the +args+ to prevent
         # problems with nil values.
         def resolve(field, *args, array: false, decorate: false, &block)
+          tracer = request.tracer if args.empty?
+          started_at = tracer&.clock
           resolve_data_for(field, args)
 
-          value = args.last
+          value = await(args.last)
+          tracer&.add(field, started_at)
           value = field.decorate(value) if decorate
           context.stacked(value) do |current|
             if !array
@@ -126,13 +149,38 @@ module Rails
           end
         end
 
+        # When enabled, call the resolvers of the fields in the +selection+
+        # before writing any of them, so that resolvers returning promises run
+        # concurrently instead of one after the other
+        def resolve_ahead(selection)
+          return yield unless schema.config.async_field_resolution
+
+          fields = selection.each_value.select { |item| item.try(:resolve_ahead?) }
+          return yield if fields.size < 2
+
+          frame = fields.each_with_object({}) do |field, result|
+            result[field] = stacked(field) do
+              prepared = prepared_data_for(field)
+              trigger_resolver(field, prepared)
+            rescue StandardError => error
+              Concurrent::Promises.rejected_future(error)
+            end
+          end
+
+          (@ahead ||= []) << frame
+          yield
+        ensure
+          @ahead.pop unless frame.nil?
+        end
+
         # Get the resolved data for a given field
         def resolve_data_for(field, args)
           return unless args.size.zero?
 
-          if field.try(:dynamic_resolver?)
-            prepared = prepared_data_for(field)
-            args << Event.trigger(:resolve, field, self, prepared_data: prepared, &field.resolver)
+          if defined?(@ahead) && @ahead&.last&.key?(field)
+            args << @ahead.last.delete(field)
+          elsif field.try(:dynamic_resolver?)
+            args << trigger_resolver(field, prepared_data_for(field))
           elsif field.prepared_data?
             args << prepared_data_for(field)
           else
@@ -140,6 +188,29 @@ module Rails
           end
         end
 
+        # Call the resolver of the given +field+, timing it when the histogram
+        # of the resolvers is enabled
+        def trigger_resolver(field, prepared)
+          return Event.trigger(:resolve, field, self, prepared_data: prepared, &field.resolver) \
+            if @timings.nil?
+
+          @timings.measure(field.field) do
+            Event.trigger(:resolve, field, self, prepared_data: prepared, &field.resolver)
+          end
+        end
+
+        # Wait for the actual value when the given +value+ is still pending,
+        # like promises returned by resolvers
+        def await(value)
+          case value
+          when Concurrent::Promises::Future then value.value!
+          when ::Thread then value.value
+          else
+            defined?(::ActiveRecord::Promise) && ::ActiveRecord::Promise === value \
+              ? value.value : value
+          end
+        end
+
         # Check if the given class is in the pool, or add a new instance to the
         # pool, and then set the instance as the current object
         def instance_for(klass)
@@ -172,9 +243,7 @@ module Rails
             next unless list.include?(obj)
             next true if idx == 0
 
-            obj.all_events.try(:[], event_name)&.any? do |ev|
-              !(ev.is_a?(Callback) && ev.exclusive?)
-            end
+            shared_listeners_of(obj).include?(event_name)
           end
 
           # Now trigger with more for all the selected objects
@@ -193,6 +262,16 @@ module Rails
           end
         end
 
+        # Get the name of the events that the +object+ has at least one non
+        # exclusive callback, which is checked only once per request
+        def shared_listeners_of(object)
+          request.nested_cache(:shared_listeners, object) do
+            (object.all_events || EMPTY_HASH).each_with_object(Set.new) do |(name, list), result|
+              result << name if list.any? { |ev| !(ev.is_a?(Callback) && ev.exclusive?) }
+            end
+          end
+        end
+
         # Store a given resolve +value+ for a given +field+
         def store_data(field, value)
           @data_pool[field] = value
@@ -220,7 +299,7 @@ module Rails
 
         # Build the cache object
         def cache_dump
-          { class: self.class }
+          { class: request.unspecialized_class_of(self) }
         end
 
         # Organize from cache data
@@ -266,10 +345,10 @@ module Rails
           end
 
           # A start of the organize step
-          def collect_listeners
+          def collect_listeners(&block)
             return if defined?(@organized)
             @stage = :organize
-            yield
+            instrument_stage(&block)
           end
 
           # This is where the strategy is most effective. By preparing the tree,
@@ -283,13 +362,23 @@ module Rails
             # TODO: We don't need to traverse over the fields, we can
             # get the ones with such event and use parent to figure out
             # the stack
-            yield if force || listening_to?(:prepare)
+            instrument_stage { yield } if force || listening_to?(:prepare)
           end
 
           # Start collecting results
-          def collect_response
+          def collect_response(&block)
             @stage = :resolve
-            yield
+            instrument_stage(&block)
+          end
+
+          # Report how long the current stage took, along with the histogram
+          # of the resolvers when resolving
+          def instrument_stage
+            ActiveSupport::Notifications.instrument(STAGE_EVENTS[@stage], request: request) do |payload|
+              result = yield
+              payload[:resolvers] = @timings.flush if @stage == :resolve && !@timings.nil?
+              result
+            end
           end
 
           # Fetch the data for a given field and set as the first element
@@ -11,53 +11,34 @@ module Rails
       # operations pretty muchy skips the organize step since that is what is
       # cached.
       #
-      # Beware, if the version in the cache is different from the version in the
-      # type map, it won't be able to process it.
+      # It is used whenever +config.hard_cache_operations+ is enabled. The
+      # organized request is stored using the digest of the document and the
+      # version of the type map, so it gets invalidated when the schema changes.
+      # Arguments that come from variables are collected again when loaded, but
+      # requests with directives that depend on variables are never cached.
       class Strategy::CachedStrategy < Strategy
         self.priority = 100
 
-        class << self
-
-          # Resolve whenever it has a cache directive on any of the operations
-          def can_resolve?(request)
-            false
-            # request.operations.each_value.any? do |op|
-            #   op.data&.directives&.any? { |dir| directive_name(dir) == 'cached' }
-            # end
+        # Resolve whenever the request can be hard cached and it doesn't have
+        # any subscription, since those have their own caching process
+        def self.can_resolve?(request)
+          request.hard_cache? && request.operations.each_value.none? do |op|
+            op.of_type?(:subscription)
           end
-
-          private
-
-            def directive_name(obj)
-              Native.node_name(Native.directive_name(obj))
-            end
         end
 
-        # Executes the strategy in the normal mode
+        # Executes the strategy in the normal mode, which is similar to the
+        # sequenced strategy, but the organize step is skipped when the request
+        # was loaded from the cache
         def resolve!
           response.with_stack('data') do
-            for_each_operation { |op| collect_listeners { op.organize! } }
-            for_each_operation { |op| collect_data      { op.prepare!  } }
-            for_each_operation { |op| collect_response  { op.resolve!  } }
-
-            # collect_data(true) { op.prepare! }
-            # collect_response   { op.resolve! }
-
-            # operations.each_value do |op|
-            #   collect_listeners  { op.organize! }
-            #   collect_data(true) { op.prepare! }
-            #   collect_response   { op.resolve! }
-            # end
+            for_each_operation do |op|
+              collect_listeners          { op.organize! }
+              collect_data(op.mutation?) { op.prepare! }
+              collect_response           { op.resolve! }
+            end
           end
         end
-
-        private
-
-          # Execute a given block for each defined operation
-          def for_each_operation(&block)
-            operations.each_value(&block)
-          end
-
       end
     end
   end
@@ -8,21 +8,78 @@ module Rails
       # This is a resolution strategy to solve requests that only contain
       # queries, allowing the strategy to collect all the information for all
       # the queries in a single step before resolving it.
+      #
+      # When +config.concurrent_multi_query+ is set with the size of a pool,
+      # after organizing all the operations, each one of them will be prepared
+      # and resolved in their own thread, using their own response collector,
+      # and then merged in order.
       class Strategy::MultiQueryStrategy < Strategy
         self.priority = 10
 
-        def self.can_resolve?(request)
-          request.operations.each_value.all? { |op| op.of_type?(:query) }
+        # Stores the pools of threads, indexed by their size
+        POOLS = Concurrent::Map.new
+
+        class << self
+          def can_resolve?(request)
+            request.operations.each_value.all? { |op| op.of_type?(:query) }
+          end
+
+          # Get the pool of threads with the given +size+
+          def pool_for(size)
+            POOLS.compute_if_absent(size) { Concurrent::FixedThreadPool.new(size) }
+          end
         end
 
         # Executes the strategy in the normal mode
         def resolve!
           response.with_stack('data') do
             for_each_operation { |op| collect_listeners { op.organize! } }
-            for_each_operation { |op| collect_data      { op.prepare!  } }
-            for_each_operation { |op| collect_response  { op.resolve!  } }
+
+            if concurrent?
+              resolve_concurrently!
+            else
+              for_each_operation { |op| collect_data      { op.prepare!  } }
+              for_each_operation { |op| collect_response  { op.resolve!  } }
+            end
           end
         end
+
+        protected
+
+          # Prepare and resolve each operation in a separated thread, using a
+          # branch of both the strategy and the response
+          def resolve_concurrently!
+            pool = self.class.pool_for(schema.config.concurrent_multi_query)
+            futures = operations.each_value.map do |op|
+              other, collector = branch, response.class.new(request)
+              GraphQL.future_on(pool) do
+                request.branched(other, collector) do
+                  other.collect_data     { op.prepare! }
+                  other.collect_response { op.resolve! }
+                end
+
+                collector
+              end
+            end
+
+            GraphQL.wait_futures(futures).each { |future| response.merge!(future.value!) }
+          end
+
+        private
+
+          # Check if the operations can be resolved concurrently. Operations
+          # that share fragments can't, because fragments hold the object being
+          # resolved
+          def concurrent?
+            return false unless schema.config.concurrent_multi_query.is_a?(Integer)
+            return false if operations.size < 2 || Request.branched?
+            return false unless response.respond_to?(:merge!)
+            return true if request.fragments.blank?
+            return false if defined?(@organized)
+
+            used = operations.each_value.flat_map { |op| op.used_fragments.to_a }
+            used.size == used.uniq.size
+          end
       end
     end
   end
@@ -12,7 +12,7 @@ module Rails
         NULL_SCOPE = Object.new.freeze
 
         attr_reader :sid, :schema, :args, :field, :scope, :context, :broadcastable,
-          :origin, :created_at, :updated_at, :operation_id
+          :origin, :created_at, :updated_at, :operation_id, :variables_id
 
         alias broadcastable? broadcastable
         alias id sid
@@ -23,6 +23,7 @@ module Rails
           @schema = request.schema.namespace                           # 1 Symbol
           @origin = request.origin                                     # * HEAVY!
           @operation_id = operation.hash                               # 1 Integer
+          @variables_id = request.args.hash                            # 1 Integer
           @args = entrypoint.arguments.to_h                            # 1 Hash of GQL values
           @field = entrypoint.field                                    # 1 Pointer
           @context = request.context.to_h                              # 1 Hash +/- heavy
@@ -38,6 +39,18 @@ module Rails
           @updated_at = Time.current
         end
 
+        # Identifies which subscriptions will produce the very same result, so
+        # they can share a single execution. Subscriptions that are not
+        # broadcastable can depend on their origin, like the current user, so
+        # each one of them is executed on its own
+        def fingerprint
+          @fingerprint ||= begin
+            list = [schema, operation_id, variables_id, args.hash]
+            list << sid unless broadcastable?
+            list.hash
+          end
+        end
+
         def marshal_dump
           raise ::TypeError, +"Request subscriptions must not be used as payload."
         end
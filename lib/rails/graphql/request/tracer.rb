@@ -0,0 +1,90 @@
+# frozen_string_literal: true
+
+module Rails
+  module GraphQL
+    class Request
+      # = GraphQL Request Tracer
+      #
+      # Collects the start and duration of every resolver called by a sampled
+      # request, in the same format as Apollo Tracing. The entries are written
+      # into a buffer that grows in blocks, so tracing a request doesn't
+      # reallocate it on every field.
+      class Tracer
+        # The number of entries the buffer can hold before growing
+        CAPACITY = 256
+
+        # The number of slots each entry takes on the buffer
+        SLOTS = 4
+
+        def initialize(request)
+          @request = request
+          @buffer = Array.new(CAPACITY * SLOTS)
+          @size = 0
+          @mutex = Mutex.new
+
+          @started_at = Time.now.utc
+          @origin = clock
+        end
+
+        # The monotonic clock in nanoseconds
+        def clock
+          Process.clock_gettime(Process::CLOCK_MONOTONIC, :nanosecond)
+        end
+
+        # Add the resolver of the given request +field+, at its current path,
+        # that started at the given clock
+        def add(field, started_at)
+          duration = clock - started_at
+          path = @request.stack_to_path
+
+          @mutex.synchronize do
+            @buffer.concat(Array.new(CAPACITY * SLOTS)) if @size == @buffer.size
+            @buffer[@size] = field.field
+            @buffer[@size + 1] = path
+            @buffer[@size + 2] = started_at - @origin
+            @buffer[@size + 3] = duration
+            @size += SLOTS
+          end
+        end
+
+        # Return the trace with all the resolvers added so far
+        def to_h
+          finished_at = clock
+          resolvers = (0...@size).step(SLOTS).map do |idx|
+            field, path, offset, duration = @buffer[idx, SLOTS]
+
+            {
+              path: path,
+              parentType: @request.owner_name_of(field),
+              fieldName: field.gql_name,
+              returnType: return_type_of(field),
+              startOffset: offset,
+              duration: duration,
+            }
+          end
+
+          {
+            version: 1,
+            startTime: @started_at.iso8601(3),
+            endTime: (@started_at + (finished_at - @origin) / 1e9).iso8601(3),
+            duration: finished_at - @origin,
+            execution: { resolvers: resolvers },
+          }
+        end
+
+        private
+
+          # The GraphQL representation of the type of the +field+
+          def return_type_of(field)
+            result = +''
+            result << '[' if field.array?
+            result << field.type_klass.gql_name
+            result << '!' if field.array? && !field.nullable?
+            result << ']' if field.array?
+            result << '!' unless field.null?
+            result
+          end
+      end
+    end
+  end
+end
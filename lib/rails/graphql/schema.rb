@@ -38,6 +38,9 @@ module Rails
           enable_string_collector default_response_format
           schema_type_names cache
           default_subscription_provider default_subscription_broadcastable
+          concurrent_multi_query async_field_resolution hard_cache_operations
+          concurrent_source_build resolver_timings tracing_sample_rate
+          tracing_in_extensions
         ].to_set
 
         config.default_proc = proc do |hash, key|
@@ -354,13 +357,17 @@ module Rails
 
           # Build all sources that has the belongs to the current namespace
           def build_all_sources
-            GraphQL::Source.descendants.each do |klass|
+            list = GraphQL::Source.descendants.select do |klass|
               next if klass.abstract?
 
               ns = klass.namespaces
-              klass.build_all if (ns.blank? && namespace == :base) ||
+              (ns.blank? && namespace == :base) ||
                 ns == namespace || ns.try(:include?, namespace)
             end
+
+            threads = config.concurrent_source_build
+            GraphQL::Source.prefetch_all(list, threads) if threads.is_a?(Integer) && list.size > 1
+            list.each(&:build_all)
           end
 
           # Make sure to prefix the cache key
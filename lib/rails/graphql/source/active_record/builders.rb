@@ -52,8 +52,51 @@ module Rails
         end
       end
 
+      # Build the arguments of the keyset pagination, where +after+ is the
+      # primary key of the last record, comma-separated when it is composite
+      def build_keyset_arguments(holder)
+        holder.argument(:first, :int, null: true)
+        holder.argument(:after, :id, null: true)
+      end
+
+      # Get the SQL condition, and its binds, that seeks the records after the
+      # given +values+ of the +columns+, using the one from the adapter when
+      # available
+      def keyset_condition(columns, values)
+        adapter_key = GraphQL.ar_adapter_key(adapter_name)
+        method_name = :"#{adapter_key}_keyset_condition"
+        return send(method_name, columns, values) if respond_to?(method_name, true)
+
+        expanded_keyset_condition(columns, values)
+      end
+
       protected
 
+        # Get the quoted and table-qualified version of the given +columns+
+        def quoted_keyset_columns(columns)
+          columns.map do |column|
+            +"#{model.quoted_table_name}.#{model.connection.quote_column_name(column)}"
+          end
+        end
+
+        # Compare the columns one by one, as in a > x OR (a = x AND b > y),
+        # which works on any database
+        def expanded_keyset_condition(columns, values)
+          keys = quoted_keyset_columns(columns)
+          parts = keys.each_index.map do |index|
+            (keys.first(index).map { |key| "#{key} = ?" } << "#{keys[index]} > ?").join(' AND ')
+          end
+
+          binds = values.each_index.flat_map { |index| values.first(index + 1) }
+          [+"(#{parts.join(') OR (')})", *binds]
+        end
+
+        # Compare all the columns at once using a row value
+        def row_keyset_condition(columns, values)
+          keys = quoted_keyset_columns(columns)
+          [+"(#{keys.join(', ')}) > (#{Array.new(keys.size, '?').join(', ')})", *values]
+        end
+
         # Check if the given model is consider an interface due to single table
         # inheritance and the given model is the base class
         def sti_interface?
@@ -105,6 +148,11 @@ module Rails
                 source = owner.is_a?(Helpers::WithSchemaFields) &&
                   (owner.try(:collection_field) || owner.query_fields.try(:[], item.name))
 
+                # Keyset pagination only pages the collection field itself, so
+                # a proxy of it would expose arguments that do nothing
+                source = nil if owner.try(:keyset_pagination).present? &&
+                  source.equal?(owner.collection_field)
+
                 if source.present?
                   proxy_options = options.merge(alias: item.name, of_type: :proxy)
                   field = holder.safe_field(source, **proxy_options)
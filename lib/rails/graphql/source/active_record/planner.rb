@@ -0,0 +1,72 @@
+# frozen_string_literal: true
+
+module Rails
+  module GraphQL
+    # All the helper methods for planning what is loaded from the database
+    # based on the selection set of the request field being prepared
+    module Source::ActiveRecordSource::Planner
+      # Restrict the columns of the given +scope+ to the ones the selection of
+      # the current field needs, plus the +required+ ones. It gives up when
+      # any of the selected fields may depend on something else. Records
+      # loaded by mutations are always complete, since they may be saved
+      def select_planned_columns(scope, *required)
+        return scope unless self.class.select_columns? && scope.select_values.empty?
+        return scope if operation.mutation?
+
+        columns = planned_columns(scope.klass, event.source, required)
+        columns.nil? ? scope : scope.select(*columns)
+      end
+
+      protected
+
+        # Collect the columns of +klass+ needed by the selection of the given
+        # request +component+, or nil when all of them are needed
+        def planned_columns(klass, component, required)
+          columns_hash = klass.columns_hash
+          result = Set.new(GraphQL.enumerate(klass.primary_key))
+          required.each { |key| result.merge(GraphQL.enumerate(key)) unless key.nil? }
+          result << klass.inheritance_column if columns_hash.key?(klass.inheritance_column)
+
+          each_planned_field(component) do |field|
+            column = field.method_name.to_s
+            if columns_hash.key?(column)
+              return if field.dynamic_resolver?
+              result << column
+            elsif (reflection = klass._reflect_on_association(field.name))
+              return if reflection.through_reflection? || reflection.polymorphic?
+              result.merge(GraphQL.enumerate(owner_keys_of(reflection)))
+            else
+              return
+            end
+          end
+
+          result.size < columns_hash.size ? result.to_a : nil
+        end
+
+        # Go over all the fields in the selection, including the ones from
+        # spreads, skipping the +__typename+ ones
+        def each_planned_field(component, &block)
+          component.selection&.each_value do |item|
+            if item.is_a?(Request::Component::Field)
+              block.call(item.field)
+            elsif item.is_a?(Request::Component::Spread)
+              each_planned_field(item.inline? ? item : item.fragment, &block)
+            end
+          end
+        end
+
+        # The columns that the owner of the association must have loaded so
+        # that the preloaded records can be matched with it
+        def owner_keys_of(reflection)
+          reflection.belongs_to? ? reflection.foreign_key : reflection.active_record_primary_key
+        end
+
+        # The columns that the associated records must have loaded so that
+        # they can be matched with their owners
+        def target_keys_of(reflection)
+          return reflection.association_primary_key if reflection.belongs_to?
+          [reflection.foreign_key, reflection.type]
+        end
+    end
+  end
+end
@@ -14,7 +14,9 @@ module Rails
       include Source::ScopedArguments
 
       require_relative 'active_record/builders'
+      require_relative 'active_record/planner'
       extend Builders
+      include Planner
 
       validate_assignment('ActiveRecord::Base') do |value|
         +"The \"#{value.name}\" is not a valid Active Record model"
@@ -28,6 +30,14 @@ module Rails
       # request when trying to save records. False will disable it
       class_attribute :errors_to_extensions, instance_accessor: false, default: false
 
+      # Mark if the records loaded by this source should only select the
+      # columns that the selection set of the request actually needs
+      class_attribute :select_columns, instance_accessor: false, default: false
+
+      # Set the page size of the keyset pagination of the collection field,
+      # which adds +first+ and +after+ arguments to it. False will disable it
+      class_attribute :keyset_pagination, instance_accessor: false, default: false
+
       # Marks if the source should be threated as an interface, meaning that
       # no object will be created, instead an interface will
       class_attribute :act_as_interface, instance_accessor: false
@@ -81,6 +91,7 @@ module Rails
         type = interface? ? interface : object
 
         safe_field(plural, type, full: true) do
+          build_keyset_arguments(self) if keyset_pagination
           before_resolve(:load_records)
         end
 
@@ -140,6 +151,16 @@ module Rails
           super if model&.table_exists?
         end
 
+        # Load the columns of the model, which is the part of the build that
+        # queries the database
+        def prefetch_build
+          return if abstract? || model.nil?
+
+          model.connection_pool.with_connection do
+            model.columns_hash if model.table_exists?
+          end
+        end
+
         # Allows setting up an interface instead of an object. Mostly because
         # some models are better dealt as interfaces than actual objects
         def interface
@@ -199,14 +220,15 @@ module Rails
       # Prepare to load multiple records from the underlying model
       def load_records(scope = nil)
         scope ||= event.last_result || model.default_scoped
-        inject_scopes(scope, :relation)
+        scope = select_planned_columns(inject_scopes(scope, :relation))
+        keyset_pagination? ? keyset_page(scope) : scope
       end
 
       # Prepare to load a single record from the underlying model
       def load_record(scope = nil, find_by: nil)
         scope ||= event.last_result || model.default_scoped
         find_by ||= { primary_key => event.argument(primary_key) }
-        inject_scopes(scope, :relation).find_by(find_by)
+        select_planned_columns(inject_scopes(scope, :relation)).find_by(find_by)
       end
 
       # The perform step for the +create+ based mutation
@@ -240,7 +262,8 @@ module Rails
 
       # Collect a scope for filters applied to a given association
       def build_association_scope(association)
-        scope = model._reflect_on_association(association).klass.default_scoped
+        reflection = model._reflect_on_association(association)
+        scope = reflection.klass.default_scoped
 
         # Apply proxied injected scopes
         # TODO: Arguments comes with their proxy, so we might not need this
@@ -250,7 +273,11 @@ module Rails
         # end if proxied.present? && proxied <= Source::ActiveRecordSource
 
         # Apply self defined injected scopes
-        inject_scopes(scope, :relation)
+        scope = inject_scopes(scope, :relation)
+        return scope if reflection.through_reflection?
+
+        # Only select what is needed, plus the keys to match the owners
+        select_planned_columns(scope, *target_keys_of(reflection))
       end
 
       # Once the records are pre-loaded due to +preload_association+, use the
@@ -280,6 +307,42 @@ module Rails
           event.argument(singular)
         end
 
+        # Check if the records are being loaded for the collection field with
+        # keyset pagination, and not through a proxy of it
+        def keyset_pagination?
+          self.class.keyset_pagination.present? && !event.field.nil? &&
+            event.field.equal?(self.class.collection_field)
+        end
+
+        # Seek the page after the given cursor, ordering by the primary key so
+        # that the database only reads the rows being returned
+        def keyset_page(scope)
+          columns = GraphQL.enumerate(primary_key)
+          page_size = self.class.keyset_pagination
+          page_size = nil unless page_size.is_a?(::Integer)
+
+          first = event.argument(:first) || page_size
+          raise ::ArgumentError, (+<<~MSG).squish if first&.negative?
+            The "first" argument must not be negative.
+          MSG
+
+          first = [first, page_size].min unless first.nil? || page_size.nil?
+          scope = scope.reorder(*columns)
+          scope = scope.limit(first) unless first.nil?
+          return scope if (after = event.argument(:after)).nil?
+
+          values = columns.size == 1 ? [after] : after.to_s.split(',')
+          raise ::ArgumentError, (+<<~MSG).squish if values.size != columns.size
+            The "#{after}" cursor does not match the primary key of #{model.name}.
+          MSG
+
+          values = columns.zip(values).map do |column, value|
+            model.type_for_attribute(column).cast(value)
+          end
+
+          scope.where(self.class.keyset_condition(columns, values))
+        end
+
         # Preload the records for a given +association+ using the current value.
         # It can be further specified with a given +scope+
         # TODO: On Rails 7 we can use the Preloader::Branch class
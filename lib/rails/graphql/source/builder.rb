@@ -16,6 +16,23 @@ module Rails
           descendants.each(&:build_all)
         end
 
+        # Using a pool with the given number of +threads+, load everything
+        # that the given +sources+ need from external places to be built, so
+        # that the build itself, which is not thread-safe, does not wait on
+        # them one by one
+        def prefetch_all(sources, threads)
+          pool = Concurrent::FixedThreadPool.new(threads)
+          futures = sources.map { |klass| GraphQL.future_on(pool) { klass.prefetch_build } }
+          GraphQL.wait_futures(futures).each(&:value!)
+        ensure
+          pool&.shutdown
+        end
+
+        # Load anything needed by the build process ahead of time. It runs in a
+        # separated thread, so it must not define or register anything
+        def prefetch_build
+        end
+
         # Trigger a safe build of everything
         def build_all
           build_all! unless abstract?
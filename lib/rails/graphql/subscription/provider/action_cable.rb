@@ -10,19 +10,45 @@ module Rails
         #
         # The subscription provider associated with Rails Action Cable, that
         # delivers subscription notifications through an Action Cable Channel
+        #
+        # Events shared between the instances go through the internal channel
+        # using a compact binary format, where the method is a single byte and
+        # the sids are length-prefixed strings. Any other argument falls back
+        # to +Marshal+. When +batch: true+ is provided, events published before
+        # the event loop gets to run are merged into a single message
         # TODO: Try to serialize and deserialize the origin
         class ActionCable < Base
           INTERNAL_CHANNEL = 'rails-graphql:events'
 
+          # The header and the version of the binary format of the events
+          WIRE_HEADER = 'GQL'.b.freeze
+          WIRE_VERSION = 1
+
+          # The methods that are encoded as their index, any other one is sent
+          # as the 255 byte followed by its name
+          WIRE_METHODS = %i[
+            async_remove async_update async_remove_all async_update_all
+            async_search_and_remove async_search_and_update
+          ].freeze
+
+          # The methods that accept a list of sids, which allows events with
+          # the same extra arguments to be merged while batching
+          MERGEABLE_METHODS = %i[async_remove_all async_update_all].freeze
+
           attr_reader :cable, :prefix
 
           def initialize(*args, **options)
             @cable = options.fetch(:cable, ::ActionCable)
             @prefix = options.fetch(:prefix, 'rails-graphql')
+            @batch = options.fetch(:batch, false)
+
+            @queue = []
+            @queue_mutex = Mutex.new
 
             @event_callback = ->(message) do
-              method_name, args, xargs = Marshal.load(message)
-              @mutex.synchronize { send(method_name, *args, **xargs) }
+              decode_events(message).each do |method_name, args, xargs|
+                @mutex.synchronize { send(method_name, *args, **xargs) }
+              end
             end
 
             super
@@ -81,16 +107,144 @@ module Rails
               item.origin.stream_from(stream_name(item))
             end
 
+            # Encode the payload only once and send it to the stream of each
+            # one of the items, without encoding it again
+            def update_group(items, data, **xargs)
+              return super if data.nil? || unsubscribing?(data)
+
+              payload = { 'result' => data, 'more' => true }
+              payload = ::ActiveSupport::JSON.encode(payload)
+
+              items.each do |item|
+                log(:updated, item) do
+                  store.update!(item)
+                  cable.server.broadcast(stream_name(item), payload, coder: nil)
+                end
+              end
+            end
+
             def execute(item, **xargs)
               super(item, origin: item.origin, **xargs, as: :hash)
             end
 
             def async_exec(method_name, *args, **xargs)
-              payload = [method_name, args, store.serialize(**xargs)]
-              with_pubsub { @pubsub.broadcast(INTERNAL_CHANNEL, Marshal.dump(payload)) }
+              event = build_event(method_name, args, store.serialize(**xargs))
+
+              if @batch
+                schedule = @queue_mutex.synchronize do
+                  enqueue_event(event)
+                  !@scheduled && (@scheduled = true)
+                end
+
+                with_pubsub { flush_events } if schedule
+              else
+                with_pubsub { publish_events([event]) }
+              end
+
               nil
             end
 
+            # Split the leading sids from the other arguments, which will be
+            # dumped together with the named arguments
+            def build_event(method_name, args, xargs)
+              sids = []
+              while args.first.is_a?(::String) || instance?(args.first)
+                item = args.shift
+                sids << (instance?(item) ? item.sid : item)
+              end
+
+              extra = args.empty? && xargs.empty? ? '' : Marshal.dump([args, xargs])
+              [method_name, sids, extra]
+            end
+
+            # Add the event to the queue, merging it with the last one when
+            # possible
+            def enqueue_event(event)
+              last = @queue.last
+              mergeable = !last.nil? && MERGEABLE_METHODS.include?(event[0]) &&
+                last[0] == event[0] && last[2] == event[2]
+
+              mergeable ? last[1].concat(event[1]) : @queue << event
+            end
+
+            # Publish everything that was queued so far in a single message
+            def flush_events
+              events = @queue_mutex.synchronize do
+                @scheduled = false
+                queue, @queue = @queue, []
+                queue
+              end
+
+              publish_events(events) unless events.empty?
+            end
+
+            def publish_events(events)
+              @pubsub.broadcast(INTERNAL_CHANNEL, encode_events(events))
+            end
+
+            # Encode the list of events using the binary format
+            def encode_events(events)
+              message = [WIRE_HEADER, WIRE_VERSION, events.size].pack('a3CN')
+
+              events.each do |method_name, sids, extra|
+                method_id = WIRE_METHODS.index(method_name)
+                message << [method_id || 255].pack('C')
+                write_wire_string(message, method_name.to_s) if method_id.nil?
+
+                message << [sids.size].pack('N')
+                sids.each { |sid| write_wire_string(message, sid) }
+                write_wire_string(message, extra)
+              end
+
+              message
+            end
+
+            # Decode a message into the list of events, falling back to
+            # +Marshal+ when the message does not have the header
+            def decode_events(message)
+              return [Marshal.load(message)] unless message.start_with?(WIRE_HEADER)
+
+              version, size = message.unpack('@3CN')
+              raise ::ArgumentError, (+<<~MSG).squish if version != WIRE_VERSION
+                Unsupported version #{version} of subscription events.
+              MSG
+
+              offset = 8
+              Array.new(size) do
+                method_id = message.getbyte(offset)
+                offset += 1
+
+                method_name =
+                  if method_id == 255
+                    name, offset = read_wire_string(message, offset)
+                    name.to_sym
+                  else
+                    WIRE_METHODS[method_id]
+                  end
+
+                count = message.unpack1("@#{offset}N")
+                offset += 4
+
+                sids = Array.new(count) do
+                  sid, offset = read_wire_string(message, offset)
+                  sid.force_encoding(Encoding::UTF_8)
+                end
+
+                extra, offset = read_wire_string(message, offset)
+                args, xargs = extra.empty? ? [EMPTY_ARRAY, EMPTY_HASH] : Marshal.load(extra)
+                [method_name, sids + args, xargs]
+              end
+            end
+
+            def write_wire_string(message, value)
+              message << [value.bytesize].pack('N') << value.b
+            end
+
+            def read_wire_string(message, offset)
+              size = message.unpack1("@#{offset}N")
+              [message.byteslice(offset + 4, size), offset + 4 + size]
+            end
+
             def with_pubsub(&callback)
               success = -> { cable.server.event_loop.post(&callback) }
               return success.call if defined?(@pubsub) && !@pubsub.nil?
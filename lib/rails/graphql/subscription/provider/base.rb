@@ -103,16 +103,22 @@ module Rails
             items.each(&method(:remove))
           end
 
-          # A simple shortcut for calling update on each individual sid
+          # Update all the given sids, executing the request only once for
+          # each group of subscriptions that share the same fingerprint
           async_exec def update_all(*sids, **xargs)
             return if sids.blank?
 
-            enum = GraphQL.enumerate(store.fetch(*sids))
-            enum.group_by(&:operation_id).each_value do |subscriptions|
-              data = execute(subscriptions.first, **xargs, broadcasting: true) \
-                unless subscriptions.one? || first.broadcastable?
+            enum = GraphQL.enumerate(store.fetch(*sids)).compact
+            groups = enum.group_by(&:fingerprint)
 
-              subscriptions.each { |item| update(item, data, **xargs) }
+            log(:broadcasted, fan_out: enum.size, executions: groups.size) do
+              groups.each_value do |subscriptions|
+                next update(subscriptions.first, **xargs) if subscriptions.one?
+
+                first = subscriptions.first
+                data = execute(first, **xargs, broadcasting: first.broadcastable?)
+                update_group(subscriptions, data, **xargs)
+              end
             end
           end
 
@@ -151,9 +157,14 @@ module Rails
               object.is_a?(Request::Subscription)
             end
 
+            # Deliver the same +data+ to all the given +items+
+            def update_group(items, data, **xargs)
+              items.each { |item| update(item, data, **xargs) }
+            end
+
             # Logo a given +event+ for the given +item+
-            def log(event, item = nil, &block)
-              data = { item: item, type: event, provider: self }
+            def log(event, item = nil, **extra, &block)
+              data = { item: item, type: event, provider: self, **extra }
               ActiveSupport::Notifications.instrument('subscription.graphql', **data, &block)
             end
 
@@ -163,7 +174,7 @@ module Rails
               catch(:skip_subscription_update) do
                 context = subscription.context.dup
                 context[:broadcasting] = true if broadcasting
-                xargs.reverse_merge(context: context, as: :string)
+                xargs = xargs.reverse_merge(context: context, as: :string)
 
                 namespace = subscription.schema
                 Request.execute(nil, **xargs, namespace: namespace, hash: subscription.sid)
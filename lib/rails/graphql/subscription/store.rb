@@ -13,6 +13,7 @@ module Rails
 
         autoload :Base
         autoload :Memory
+        autoload :Native
       end
     end
   end
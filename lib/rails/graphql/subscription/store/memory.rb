@@ -36,7 +36,7 @@ module Rails
 
             xargs[:field] = hash_for(xargs[:field])
             xargs[:scope] = possible_scopes(xargs[:scope])
-            xargs[:args] = Array.wrap(xargs[:args]).map(&method(:hash_for))
+            xargs[:args] = Array.wrap(xargs[:args]).map(&method(:hash_for)) unless xargs[:args].nil?
             xargs
           end
 
@@ -107,7 +107,7 @@ module Rails
             [].tap do |result|
               GraphQL.enumerate(field || index.keys).each do |key1|
                 GraphQL.enumerate(scope || index[key1].keys).each do |key2|
-                  GraphQL.enumerate(args || index[key2].keys).each do |key3|
+                  GraphQL.enumerate(args || index[key1][key2].keys).each do |key3|
                     items = index.fetch(key1, nil)&.fetch(key2, nil)&.fetch(key3, nil)
                     items.each(&list.method(:[])).each(&block) unless block.nil?
                     result.concat(items || EMPTY_ARRAY)
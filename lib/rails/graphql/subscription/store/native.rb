@@ -0,0 +1,119 @@
+# frozen_string_literal: true
+
+module Rails
+  module GraphQL
+    module Subscription
+      module Store
+        # = GraphQL Native Subscription Store
+        #
+        # This store works exactly like the memory one, but the index of field,
+        # scope, and arguments is kept by the C extension, using plain integer
+        # keys. That reduces the memory footprint of each subscription and
+        # allows searches to happen without allocating intermediate objects
+        class Native < Memory
+          # The native index uses unsigned 64-bit keys, so any other value is
+          # turned into one of them
+          KEY_MASK = 0xFFFF_FFFF_FFFF_FFFF
+
+          # Integers below this key are used as they are, the key itself is
+          # used for a nil scope, and any other value is hashed with the
+          # +HASH_BIT+ set, so none of them can collide with a plain integer
+          NIL_KEY = 0x7FFF_FFFF_FFFF_FFFF
+          HASH_BIT = 0x8000_0000_0000_0000
+
+          attr_reader :slots
+
+          def initialize
+            # The list store a simple association between sid and subscription
+            @list = Concurrent::Map.new
+
+            # The slots store where the sid was placed in the native index
+            @slots = Concurrent::Map.new
+
+            # The native index, which holds each sid by its field, scope, and
+            # arguments. It is not thread-safe, so every access is synchronized
+            @index = ::GQLParser::SubscriptionIndex.new
+            @mutex = Mutex.new
+          end
+
+          def add(subscription)
+            if has?(subscription.sid)
+              raise ::ArgumentError, +"SID #{subscription.sid} is already taken."
+            end
+
+            unless subscription.sid.is_a?(::String)
+              raise ::ArgumentError, (+<<~MSG).squish
+                The native store only supports String SIDs, but
+                #{subscription.sid.inspect} was given.
+              MSG
+            end
+
+            # Rewrite the scope, to save memory
+            scope = possible_scopes(subscription.scope)&.first
+            subscription.instance_variable_set(:@scope, scope)
+
+            # Save to the list and to the index
+            list[subscription.sid] = subscription
+            path = subscription_to_index(subscription).map(&method(:index_key))
+            slots[subscription.sid] = @mutex.synchronize do
+              index.add(subscription.sid, *path)
+            end
+
+            subscription.sid
+          end
+
+          def remove(item)
+            return unless has?(item)
+
+            sid = instance?(item) ? item.sid : item
+            slot = slots.delete(sid)
+            @mutex.synchronize { index.remove(slot) } unless slot.nil?
+            list.delete(sid)
+          end
+
+          def search(**xargs, &block)
+            xargs = serialize(**xargs)
+            field, scope, args = xargs.values_at(:field, :scope, :args)
+
+            if field.nil? && args.nil? && scope.nil?
+              list.each(&block) unless block.nil?
+              return all
+            end
+
+            field, scope, args = index_keys(field), index_keys(scope), index_keys(args)
+            result = @mutex.synchronize { index.search(field, scope, args) }
+            result.each(&block) unless block.nil?
+            result
+          end
+
+          alias find_each search
+
+          # Get the number of bytes used by the index, which can be used to
+          # estimate the cost of each subscription
+          def memsize
+            index.memsize
+          end
+
+          protected
+
+            # Turn the given +value+ into a key that the native index accepts,
+            # which are integers of up to 64 bits. Anything else, like floats,
+            # negative and bigger numbers, are replaced by their hash
+            def index_key(value)
+              return NIL_KEY if value.nil?
+              return value if value.is_a?(::Integer) && value >= 0 && value < NIL_KEY
+
+              (value.hash & KEY_MASK) | HASH_BIT
+            end
+
+            # Same as above, but for when it can be a list of values, where nil
+            # means that any key matches
+            def index_keys(value)
+              return if value.nil?
+              value.is_a?(::Array) ? value.map(&method(:index_key)) : index_key(value)
+            end
+        end
+      end
+    end
+  end
+end
@@ -7,6 +7,8 @@ module Rails
       # ensuring the UTF-8 encoding and performing the necessary conversion.
       #
       # It also rely on ActiveModel so it can easily share the same Data object.
+      # The encoding and decoding happen in the C extension, and the encoded
+      # value does not contain line feeds, as required by the RFC.
       class Scalar::BinaryScalar < Scalar
         aliases :file
 
@@ -19,11 +21,11 @@ module Rails
 
         class << self
           def as_json(value)
-            Base64.encode64(value.to_s).chomp
+            GQLParser.encode64(value.to_s)
           end
 
           def deserialize(value)
-            ActiveModel::Type::Binary::Data.new(Base64.decode64(value))
+            ActiveModel::Type::Binary::Data.new(GQLParser.decode64(value))
           end
         end
       end
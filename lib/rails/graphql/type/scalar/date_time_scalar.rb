@@ -4,6 +4,9 @@ module Rails
   module GraphQL
     class Type
       # DateTime uses a ISO 8601 string to exchange the value.
+      #
+      # Both parsing and formatting happen in the C extension, which falls back
+      # to Ruby only for years that it does not handle.
       class Scalar::DateTimeScalar < Scalar
         aliases :datetime
 
@@ -13,7 +16,7 @@ module Rails
 
         class << self
           def valid_input?(value)
-            super && !!(Time.iso8601(value) rescue false)
+            super && !GQLParser.parse_iso8601(value).nil?
           end
 
           def valid_output?(value)
@@ -21,11 +24,12 @@ module Rails
           end
 
           def as_json(value)
-            value.to_time.iso8601
+            value = value.to_time
+            GQLParser.format_iso8601(value) || value.iso8601
           end
 
           def deserialize(value)
-            Time.iso8601(value)
+            GQLParser.parse_iso8601(value)
           end
         end
       end
@@ -1,6 +1,7 @@
 # frozen_string_literal: true
 
 require 'concurrent/map'
+require 'concurrent/atomic/atomic_fixnum'
 
 module Rails
   module GraphQL
@@ -15,6 +16,10 @@ module Rails
     #
     # The cache stores in the following structure:
     # Namespace -> BaseClass -> ItemKey -> Item
+    #
+    # Once everything is loaded, a frozen snapshot of the index, with all the
+    # aliases already resolved, can be compiled through +snapshot!+. Lookups
+    # will use it for as long as nothing else is added or removed.
     class TypeMap
       extend ActiveSupport::Autoload
 
@@ -37,6 +42,11 @@ module Rails
         @version = nil # Make sure to not keep the same version
         @skip_register = nil
 
+        # Every change to the index moves the revision, which invalidates the
+        # compiled snapshot
+        @revision = Concurrent::AtomicFixnum.new
+        @snapshot = nil
+
         @pending = Concurrent::Array.new
         @reported_fallbacks = Concurrent::Set.new
 
@@ -145,8 +155,10 @@ module Rails
       end
 
       # Unregister all the provided objects by simply assigning nil to their
-      # final value on the index
+      # final value on the index. Since the schema changed, the version must
+      # change as well
       def unregister(*objects)
+        @version = nil
         objects.each do |object|
           namespaces = sanitize_namespaces(namespaces: object.namespaces, exclusive: true)
           namespaces << :base if namespaces.empty?
@@ -154,6 +166,7 @@ module Rails
 
           if object.kind != :source
             @index[namespaces.first][base_class][object.to_sym] = nil
+            @revision.increment
             @objects -= 1
           end
 
@@ -211,7 +224,51 @@ module Rails
 
       # Find the given key or name inside the base class either on the given
       # namespace or in the base +:base+ namespace
-      def fetch(key_or_name, prevent_register: nil, **xargs)
+      def fetch(key_or_name, **xargs)
+        snapshot = @snapshot
+        return fetch_from_index(key_or_name, **xargs) \
+          if snapshot.nil? || snapshot[0] != @revision.value || !@pending.empty? ||
+            key_or_name.is_a?(::Array) || xargs.key?(:fallback)
+
+        fetch_from_snapshot(snapshot[1], key_or_name, xargs)
+      end
+
+      # Load everything that is pending and compile the frozen snapshot of the
+      # index, resolving all the aliases
+      def snapshot!
+        load_dependencies!(_ns: @dependencies.keys)
+        register_pending!
+
+        revision = @revision.value
+        compiled = @index.each_pair.each_with_object({}) do |(namespace, base_classes), h1|
+          h1[namespace] = base_classes.each_pair.each_with_object({}) do |(base_class, items), h2|
+            h2[base_class] = items.each_pair.each_with_object({}) do |(key, value), h3|
+              value = value.call if value.is_a?(Proc)
+              h3[key] = value unless value.nil?
+            end.freeze
+          end.freeze
+        end
+
+        @snapshot = [revision, compiled.freeze].freeze
+        compile_event_chains!(compiled, revision)
+        self
+      end
+
+      # Check if the compiled snapshot is still valid
+      def snapshot?
+        !snapshot_revision.nil?
+      end
+
+      # Get the revision of the compiled snapshot, but only if it is still
+      # valid, so that other objects can cache what they build from it
+      def snapshot_revision
+        snapshot = @snapshot
+        snapshot[0] if !snapshot.nil? && snapshot[0] == @revision.value
+      end
+
+      # Find the given key or name inside the base class straight from the
+      # index, registering any pending object
+      def fetch_from_index(key_or_name, prevent_register: nil, **xargs)
         prevent_register = true if @pending.blank?
         if prevent_register != true
           items = prevent_register == true ? nil : ::Array.wrap(prevent_register)
@@ -322,6 +379,7 @@ module Rails
         # Add a item to the index and then trigger the callbacks if any
         def add(namespace, base_class, key, raw_result)
           @index[namespace][base_class][key] = raw_result
+          @revision.increment
           return unless callbacks.key?(key)
 
           result = nil
@@ -333,6 +391,55 @@ module Rails
           callbacks.delete(key) if callbacks[key].empty?
         end
 
+        # Find the given key in the compiled +index+, following the same order
+        # of namespaces that +sanitize_namespaces+ produces, but without
+        # allocating any intermediate object
+        def fetch_from_snapshot(index, key, xargs)
+          base_class = xargs.fetch(:base_class, :Type)
+
+          if (namespaces = xargs[:_ns]).nil?
+            namespaces = xargs[:namespaces] || xargs[:namespace]
+            check_base = !xargs.fetch(:exclusive, false)
+          end
+
+          if namespaces.is_a?(::Symbol)
+            result = index.dig(namespaces, base_class, key)
+            return result unless result.nil?
+          else
+            namespaces&.each do |namespace|
+              result = index.dig(namespace, base_class, key)
+              return result unless result.nil?
+            end
+          end
+
+          index.dig(:base, base_class, key) if check_base
+        end
+
+        # Compile the event chain of every output field from the types and
+        # the schemas of the snapshot, so that requests only read them
+        def compile_event_chains!(index, revision)
+          objects = index.each_value.flat_map do |base_classes|
+            base_classes.values_at(:Type, :Schema).compact.flat_map(&:values)
+          end
+
+          objects.uniq.each do |object|
+            lists =
+              if object.is_a?(Helpers::WithSchemaFields)
+                Helpers::WithSchemaFields::TYPE_FIELD_CLASS.each_key.map do |type|
+                  object.fields_for(type)
+                end
+              elsif object.is_a?(Helpers::WithFields)
+                [object.fields]
+              end
+
+            lists&.each do |list|
+              list&.each_value do |field|
+                field.compile_event_chain!(revision) if field.is_a?(Field::OutputField)
+              end
+            end
+          end
+        end
+
         # Make sure to parse the provided options and names and return a
         # quality list of namespaces
         def sanitize_namespaces(**xargs)
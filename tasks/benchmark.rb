@@ -0,0 +1,43 @@
+# frozen_string_literal: true
+
+require 'rbconfig'
+
+namespace :benchmark do
+  harness_dir = File.expand_path('../benchmarks/parser', __dir__)
+  execution_dir = File.expand_path('../benchmarks/execution', __dir__)
+  output = File.expand_path('../tmp/benchmark/parser_harness', __dir__)
+
+  desc 'Build the standalone harness for the parser'
+  task :build_parser do
+    config = RbConfig::CONFIG
+    sources = Dir[File.expand_path('../ext/*.c', __dir__)] << File.join(harness_dir, 'harness.c')
+    includes = [config['rubyhdrdir'], config['rubyarchhdrdir'], File.expand_path('../ext', __dir__)]
+
+    mkdir_p File.dirname(output)
+    sh [
+      config['CC'], '-O3', '-o', output,
+      *includes.map { |dir| "-I#{dir}" },
+      *sources,
+      config['LIBRUBYARG'], config['LIBS'],
+    ].join(' ')
+  end
+
+  desc 'Measure the throughput of the parser over the corpus of documents'
+  task parser: :build_parser do
+    seconds = ENV.fetch('SECONDS', '1')
+    sh output, '--seconds', seconds, *Dir[File.join(harness_dir, 'corpus/*.graphql')].sort
+  end
+
+  desc 'Measure the execution of requests over the schemas and shapes of the suite'
+  task :execution do
+    args = ['--seconds', ENV.fetch('SECONDS', '2')]
+    args.push('--only', ENV['ONLY']) if ENV.key?('ONLY')
+    args.push('--output', ENV['OUTPUT']) if ENV.key?('OUTPUT')
+    ruby File.join(execution_dir, 'run.rb'), *args
+  end
+
+  desc 'Compare two results of the execution benchmark, given as BEFORE and AFTER'
+  task :compare do
+    ruby File.join(execution_dir, 'compare.rb'), ENV.fetch('BEFORE'), ENV.fetch('AFTER')
+  end
+end
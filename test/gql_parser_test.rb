@@ -0,0 +1,194 @@
+require 'config'
+
+class GQLParserTest < GraphQL::TestCase
+  DESCRIBED_CLASS = ::GQLParser
+
+  def test_decode_variables
+    assert_equal({}, DESCRIBED_CLASS.decode_variables(''))
+    assert_equal({}, DESCRIBED_CLASS.decode_variables(' null '))
+    assert_equal({}, DESCRIBED_CLASS.decode_variables('{}'))
+
+    result = DESCRIBED_CLASS.decode_variables('{"a": "ç\n", "b": 1.5e3, "c": null, "d": [true, {"e": 1}]}')
+    assert_equal({ 'a' => "ç\n", 'b' => 1500.0, 'c' => nil, 'd' => [true, { 'e' => 1 }] }, result)
+    assert_equal(Encoding::UTF_8, result['a'].encoding)
+  end
+
+  def test_decode_variables_with_definitions
+    definitions = variable_definitions(<<~GQL)
+      query($a: [Int!]!, $b: String, $c: Float, $d: Boolean!, $e: ID, $f: Other) { x }
+    GQL
+
+    result = DESCRIBED_CLASS.decode_variables(<<~JSON, definitions)
+      {"a": [1, 2], "b": "x", "c": 1, "d": true, "e": 5, "f": {"g": [1]}}
+    JSON
+
+    assert_equal({ 'a' => [1, 2], 'b' => 'x', 'c' => 1.0, 'd' => true, 'e' => '5', 'f' => { 'g' => [1] } }, result)
+    assert_equal({ 'a' => [1] }, DESCRIBED_CLASS.decode_variables('{"a": 1}', definitions))
+  end
+
+  def test_decode_variables_errors
+    definitions = variable_definitions('query($a: [Int!]!, $b: String, $d: Boolean!) { x }')
+
+    error = assert_raises(DESCRIBED_CLASS::VariablesError) do
+      DESCRIBED_CLASS.decode_variables('{"a": [null], "b": 1, "d": "x"}', definitions)
+    end
+
+    assert_kind_of(DESCRIBED_CLASS::ParserError, error)
+    assert_equal([
+      'Variable $a can not be null',
+      'Invalid value 1 provided to $b variable',
+      'Invalid value "x" provided to $d variable',
+    ], error.errors)
+
+    assert_raises(DESCRIBED_CLASS::VariablesError) do
+      DESCRIBED_CLASS.decode_variables('{"a": [2147483648]}', definitions)
+    end
+
+    assert_raises(DESCRIBED_CLASS::ParserError) { DESCRIBED_CLASS.decode_variables('{"a": 1') }
+    assert_raises(DESCRIBED_CLASS::ParserError) { DESCRIBED_CLASS.decode_variables('[1]') }
+    assert_raises(DESCRIBED_CLASS::ParserError) { DESCRIBED_CLASS.decode_variables('{} 1') }
+    assert_raises(ArgumentError) { DESCRIBED_CLASS.decode_variables(1) }
+  end
+
+  def test_parser
+    parser = DESCRIBED_CLASS::Parser.new
+    assert_equal(0, parser.peak)
+    assert_equal(0, parser.capacity)
+
+    document = '{ a b c(d: 1, e: 2) { f g } }'
+    assert_equal(DESCRIBED_CLASS.parse_execution(document), parser.parse_execution(document))
+
+    peak, capacity = parser.peak, parser.capacity
+    assert_operator(peak, :>=, 3)
+    assert_operator(capacity, :>=, peak)
+
+    parser.parse_execution('{ a }')
+    assert_equal(peak, parser.peak)
+    assert_equal(capacity, parser.capacity)
+
+    assert_raises(DESCRIBED_CLASS::ParserError) { parser.parse_execution('{ a b ') }
+    assert_equal(%w[a], field_names(parser.parse_execution('{ a }')))
+
+    assert_same(parser, parser.reset)
+    assert_equal(0, parser.peak)
+    assert_equal(0, parser.capacity)
+    assert_equal(%w[a], field_names(parser.parse_execution('{ a }')))
+  end
+
+  def test_parser_stats
+    parser = DESCRIBED_CLASS::Parser.new
+    keys = %i[bytes tokens nodes allocations nanoseconds]
+    assert_equal(keys.to_h { |key| [key, 0] }, parser.stats)
+
+    parser.parse_execution('{ a b { c } }')
+    stats = parser.stats
+    assert_equal(keys, stats.keys)
+    assert_equal(13, stats[:bytes])
+    assert_equal(8, stats[:tokens])
+    assert_equal(7, stats[:nodes])
+    assert_operator(stats[:allocations], :>, 0)
+    assert_operator(stats[:nanoseconds], :>, 0)
+
+    assert_raises(DESCRIBED_CLASS::ParserError) { parser.parse_execution('{ a ') }
+    assert_equal(stats, parser.stats)
+  end
+
+  def test_parser_current
+    parser = DESCRIBED_CLASS::Parser.current
+    assert_kind_of(DESCRIBED_CLASS::Parser, parser)
+    assert_same(parser, DESCRIBED_CLASS::Parser.current)
+    refute_same(parser, Thread.new { DESCRIBED_CLASS::Parser.current }.join.value)
+  end
+
+  def test_parser_reentrancy
+    parser = DESCRIBED_CLASS::Parser.current
+    nested = []
+
+    DESCRIBED_CLASS::Token.send(:define_method, :__setobj__) do |value|
+      if nested.empty?
+        nested << nil
+        nested << (parser.parse_execution('{ b }') rescue $!)
+        nested << (parser.reset rescue $!)
+        nested << DESCRIBED_CLASS.parse_execution('{ c }')
+      end
+
+      super(value)
+    end
+
+    assert_equal(%w[a], field_names(parser.parse_execution('{ a }')))
+
+    assert_kind_of(RuntimeError, nested[1])
+    assert_kind_of(RuntimeError, nested[2])
+    assert_equal(%w[c], field_names(nested[3]))
+  ensure
+    DESCRIBED_CLASS::Token.send(:remove_method, :__setobj__)
+  end
+
+  def test_minify
+    document = <<~GQL
+      query Hero($id: ID! = "1", $list: [[Int!]]) @a(b: true) {
+        # The hero and its friends
+        hero(id: $id, x: 1.5e3, s: "a, b") {
+          name, ...Frag
+          ... on Droid @skip(if: false) { primary }
+        }
+      }
+
+      fragment Frag on Hero { id friends(first: 10) { name } }
+    GQL
+
+    result = DESCRIBED_CLASS.minify(document)
+    assert_equal(<<~GQL.chomp, result)
+      query Hero($id:ID!="1"$list:[[Int!]])@a(b:true){hero(id:$id x:1.5e3 s:"a, b"){name ...Frag ...on Droid@skip(if:false){primary}}}fragment Frag on Hero{id friends(first:10){name}}
+    GQL
+
+    assert_equal(result, DESCRIBED_CLASS.minify(result))
+    assert_equal(parsed_structure(document), parsed_structure(result))
+    assert_raises(ArgumentError) { DESCRIBED_CLASS.minify(1) }
+
+    # The contents of hash literals are kept as they are
+    document = '{ a(b: { c: 1,  d: "e  f" }, g: [{h: 1}, 2]) { i } }'
+    assert_equal('{a(b:{ c: 1,  d: "e  f" }g:[{h: 1}2]){i}}', DESCRIBED_CLASS.minify(document))
+  end
+
+  def test_print_execution
+    documents = [
+      %({ a: b c(d: ENUM, e: null, g: """block\nstr""") }),
+      "mutation M { x(y: -1) }\n\nsubscription S { z }",
+      'query($a: [Int!]! = 1) @b { ... @c { d } ...E } fragment E on F @g { h }',
+      "fragment F on T { z }\nquery B { w ...F }",
+      'query A { a } fragment F on T { z } query B { ...F } fragment G on T { y }',
+      'query($a: I = {b: 1,  c: "d"}) { e(f: { g: 1 }) }',
+    ]
+
+    documents.each do |document|
+      parsed = DESCRIBED_CLASS.parse_execution(document)
+      result = DESCRIBED_CLASS.print_execution(parsed)
+
+      assert_equal(DESCRIBED_CLASS.minify(document), result)
+      assert_equal(parsed.inspect, parsed_structure(result))
+      assert_equal(result, DESCRIBED_CLASS.print_execution(DESCRIBED_CLASS.parse_execution(result)))
+    end
+
+    first = DESCRIBED_CLASS.parse_execution("{\n  a(b: 1),\n  c\n}")
+    second = DESCRIBED_CLASS.parse_execution('{a(b:1)c}')
+    assert_equal(DESCRIBED_CLASS.print_execution(first), DESCRIBED_CLASS.print_execution(second))
+  end
+
+  private
+
+    def parsed_structure(document)
+      DESCRIBED_CLASS.parse_execution(document).inspect
+    end
+
+    def field_names(document)
+      document[0][0][4].map { |field| field[0].to_s }
+    end
+
+    def variable_definitions(document)
+      operation = DESCRIBED_CLASS.parse_execution(document)[0][0]
+      operation[2].each_with_object({}) do |(name, (type_name, dimensions, nullability)), result|
+        result[name.to_s] = [type_name.to_s, dimensions, nullability]
+      end
+    end
+end
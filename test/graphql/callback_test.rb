@@ -0,0 +1,51 @@
+require 'config'
+
+class GraphQL_CallbackTest < GraphQL::TestCase
+  DESCRIBED_CLASS = Rails::GraphQL::Callback
+
+  def test_parameters_plan
+    block = proc { |a, b = 1, *c, d:, e: 2, **f| }
+    other = ->(x, y:) { }
+    object = DESCRIBED_CLASS.new(target, :event, &block)
+
+    stubbed_config(:callback_inject_arguments, true) do
+      stubbed_config(:callback_inject_named_arguments, true) do
+        plan = object.send(:parameters_plan, block)
+        assert_equal([[:req, :a, 0], [:req, :b, 1], [:keyreq, :d], [:key, :e]], plan)
+        assert_same(plan, object.send(:parameters_plan, block))
+        assert_equal([[:req, :x, 0], [:keyreq, :y]], object.send(:parameters_plan, other))
+      end
+
+      stubbed_config(:callback_inject_named_arguments, false) do
+        assert_equal([[:req, :a, 0], [:req, :b, 1]], object.send(:parameters_plan, block))
+      end
+    end
+
+    stubbed_config(:callback_inject_arguments, false) do
+      stubbed_config(:callback_inject_named_arguments, false) do
+        assert_empty(object.send(:parameters_plan, block))
+      end
+    end
+  end
+
+  def test_parameters_plan_of_methods
+    klass1 = Class.new { def sample(x, y:); end }
+    klass2 = Class.new { def sample(z); end }
+    object = DESCRIBED_CLASS.new(target, :event, :sample)
+
+    stubbed_config(:callback_inject_arguments, true) do
+      stubbed_config(:callback_inject_named_arguments, true) do
+        plan = object.send(:parameters_plan, klass1.new.method(:sample))
+        assert_equal([[:req, :x, 0], [:keyreq, :y]], plan)
+        assert_same(plan, object.send(:parameters_plan, klass1.new.method(:sample)))
+        assert_equal([[:req, :z, 0]], object.send(:parameters_plan, klass2.new.method(:sample)))
+      end
+    end
+  end
+
+  private
+
+    def target
+      double(event_filters: {})
+    end
+end
@@ -0,0 +1,80 @@
+require 'config'
+
+class GraphQL_Collectors_HashCollectorTest < GraphQL::TestCase
+  DESCRIBED_CLASS = Rails::GraphQL::Collectors::HashCollector
+
+  def test_sized_lists
+    object = DESCRIBED_CLASS.new(nil)
+    object.with_stack('data', size: 1) do
+      object.with_stack(-'items', array: true, size: 3) do
+        object.add(-'id', 1)
+        object.next
+        object.next
+      end
+
+      object.with_stack(-'tags', array: true, plain: true, size: 3) do
+        object.add(nil, 'a')
+      end
+    end
+
+    assert_equal({ 'data' => { 'items' => [{ 'id' => 1 }, {}], 'tags' => ['a'] } }, object.to_h)
+  end
+
+  def test_shared_keys
+    key = -'name'
+    object = DESCRIBED_CLASS.new(nil)
+    object.with_stack(key, array: true, size: 2) do
+      2.times do
+        object.add(key, 'a')
+        object.next
+      end
+
+      object.add(:other, 'b')
+      object.next
+    end
+
+    rows = object.to_h[key]
+    assert(rows.first.keys.first.equal?(key))
+    assert(rows.second.keys.first.equal?(key))
+    assert_equal(['other'], rows.last.keys)
+  end
+
+  def test_failed_stack
+    object = DESCRIBED_CLASS.new(nil)
+    object.add('a', 1)
+
+    assert_raises(StandardError) do
+      object.with_stack('b', array: true, size: 2) do
+        object.add('c', 2)
+        raise StandardError
+      end
+    end
+
+    object.add('d', 3)
+    assert_equal({ 'a' => 1, 'd' => 3 }, object.to_h)
+  end
+
+  def test_to_s
+    object = DESCRIBED_CLASS.new(nil)
+    object.add('a', "<\u2028>")
+    assert_equal("{\"a\":\"<\u2028>\"}", object.to_s)
+
+    $config.stub(:encode_with_active_support?, true) do
+      assert_equal(ActiveSupport::JSON.encode(object.to_h), object.to_s)
+    end
+  end
+
+  def test_to_s_with_non_finite_floats
+    object = DESCRIBED_CLASS.new(nil)
+    object.add('a', Float::NAN)
+    object.add('b', Float::INFINITY)
+    object.add('c', '<')
+
+    assert_raises(JSON::GeneratorError) { object.to_s }
+
+    $config.stub(:encode_with_active_support?, true) do
+      expected = ActiveSupport::JSON.encode('a' => nil, 'b' => nil, 'c' => '<')
+      assert_equal(expected, object.to_s)
+    end
+  end
+end
@@ -0,0 +1,28 @@
+require 'config'
+
+class GraphQL_Collectors_JsonCollectorTest < GraphQL::TestCase
+  DESCRIBED_CLASS = Rails::GraphQL::Collectors::JsonCollector
+
+  def test_encoded_keys
+    key = -'name'
+    object = DESCRIBED_CLASS.new(nil)
+    object.with_stack(-'items', array: true) do
+      2.times do
+        object.add(key, '"a"')
+        object.next
+      end
+
+      object.add(+'other', '"b"')
+      object.next
+    end
+
+    assert_equal('{"items":[{"name":"a"},{"name":"a"},{"other":"b"}]}', object.to_s)
+
+    encoded = object.instance_variable_get(:@encoded_keys)
+    assert_equal(2, encoded.size)
+    assert(encoded[key].frozen?)
+    assert_equal('"name":', encoded[key])
+    assert_same(encoded[key], object.send(:encoded_key, key))
+    refute_same(object.send(:encoded_key, +'name'), object.send(:encoded_key, +'name'))
+  end
+end
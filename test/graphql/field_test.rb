@@ -0,0 +1,59 @@
+require 'config'
+
+class GraphQL_FieldTest < GraphQL::TestCase
+  DESCRIBED_CLASS = Rails::GraphQL::Field
+
+  def test_compiled_events
+    calls, revision = 0, nil
+    events = { finalize: [1] }
+
+    field = double(DESCRIBED_CLASS.allocate,
+      all_events: -> { calls += 1; events },
+      all_listeners: -> { events.keys },
+    )
+
+    Rails::GraphQL.stub(:type_map, double(snapshot_revision: -> { revision })) do
+      # Without a snapshot, everything is merged every time
+      assert_same(events, field.compiled_events)
+      assert_same(events, field.compiled_events)
+      assert_equal(%i[finalize], field.compiled_listeners)
+      assert_equal(2, calls)
+      refute(field.instance_variable_defined?(:@event_chain))
+
+      # With a snapshot, they are only merged when it is built
+      revision = 1
+      assert_same(events, field.compiled_events)
+      assert_equal(3, calls)
+      refute(field.instance_variable_defined?(:@event_chain))
+
+      field.compile_event_chain!(1)
+      compiled = field.compiled_events
+      assert_equal(events, compiled)
+      assert(compiled.frozen?)
+      assert(compiled[:finalize].frozen?)
+      assert_same(compiled, field.compiled_events)
+      assert(field.compiled_listeners.frozen?)
+      assert_equal(4, calls)
+
+      # Once the snapshot changes, they go back to being merged
+      revision = 2
+      assert_same(events, field.compiled_events)
+      assert_equal(5, calls)
+    end
+  end
+
+  def test_compiled_events_when_empty
+    field = double(DESCRIBED_CLASS.allocate, all_events: {}, all_listeners: nil)
+
+    Rails::GraphQL.stub(:type_map, double(snapshot_revision: nil)) do
+      assert_nil(field.compiled_events)
+      assert_nil(field.compiled_listeners)
+    end
+
+    Rails::GraphQL.stub(:type_map, double(snapshot_revision: 1)) do
+      field.compile_event_chain!(1)
+      assert_nil(field.compiled_events)
+      assert_nil(field.compiled_listeners)
+    end
+  end
+end
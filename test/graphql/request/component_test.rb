@@ -0,0 +1,17 @@
+require 'config'
+
+class GraphQL_Request_ComponentTest < GraphQL::TestCase
+  DESCRIBED_CLASS = Rails::GraphQL::Request::Component::Field
+
+  def test_response_key
+    object = double(DESCRIBED_CLASS.allocate, gql_name: +'name')
+    key = object.response_key
+
+    assert(key.frozen?)
+    assert_equal('name', key)
+    assert_same(key, object.response_key)
+    assert_same(-'name', key)
+
+    assert_nil(double(DESCRIBED_CLASS.allocate, gql_name: nil).response_key)
+  end
+end
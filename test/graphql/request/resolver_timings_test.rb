@@ -0,0 +1,50 @@
+require 'config'
+
+class GraphQL_Request_ResolverTimingsTest < GraphQL::TestCase
+  DESCRIBED_CLASS = Rails::GraphQL::Request::ResolverTimings
+
+  def test_add
+    object = DESCRIBED_CLASS.new(request)
+    object.add(field_a, 0.05)
+    object.add(field_a, 3)
+    object.add(field_a, 2000)
+    object.add(field_b, 0.5)
+
+    result = object.flush
+    assert_equal(%w[User.a User.b], result.keys)
+
+    entry = result['User.a']
+    assert_equal(3, entry[:count])
+    assert_in_delta(2003.05, entry[:total])
+    assert_equal(2000, entry[:max])
+    assert_equal([1, 0, 0, 1, 0, 0, 0, 0, 0, 1], entry[:buckets])
+    assert_equal([0, 1, 0, 0, 0, 0, 0, 0, 0, 0], result.dig('User.b', :buckets))
+
+    assert_equal({}, object.flush)
+  end
+
+  def test_measure
+    object = DESCRIBED_CLASS.new(request)
+    assert_equal(1, object.measure(field_a) { 1 })
+    assert_raises(StandardError) { object.measure(field_a) { raise StandardError } }
+
+    entry = object.flush['User.a']
+    assert_equal(2, entry[:count])
+    assert_operator(entry[:total], :>=, entry[:max])
+    assert_equal(2, entry[:buckets].sum)
+  end
+
+  private
+
+    def request
+      double(owner_name_of: ->(*) { 'User' })
+    end
+
+    def field_a
+      @field_a ||= double(gql_name: 'a')
+    end
+
+    def field_b
+      @field_b ||= double(gql_name: 'b')
+    end
+end
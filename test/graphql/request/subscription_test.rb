@@ -0,0 +1,31 @@
+require 'config'
+
+class GraphQL_Request_SubscriptionTest < GraphQL::TestCase
+  DESCRIBED_CLASS = Rails::GraphQL::Request::Subscription
+
+  def test_fingerprint
+    assert_equal(item('a').fingerprint, item('b').fingerprint)
+    refute_equal(item('a').fingerprint, item('b', args: { id: 2 }).fingerprint)
+    refute_equal(item('a').fingerprint, item('b', variables_id: 2).fingerprint)
+
+    first = item('a', broadcastable: false)
+    second = item('b', broadcastable: false)
+    refute_equal(first.fingerprint, second.fingerprint)
+    assert_equal(first.fingerprint, item('a', broadcastable: false).fingerprint)
+  end
+
+  private
+
+    def item(sid, broadcastable: true, args: { id: 1 }, variables_id: 1)
+      DESCRIBED_CLASS.allocate.tap do |object|
+        object.instance_variable_set(:@sid, sid)
+        object.instance_variable_set(:@schema, :base)
+        object.instance_variable_set(:@operation_id, 1)
+        object.instance_variable_set(:@variables_id, variables_id)
+        object.instance_variable_set(:@args, args)
+        object.instance_variable_set(:@scope, DESCRIBED_CLASS::NULL_SCOPE)
+        object.instance_variable_set(:@context, { user: 1 })
+        object.instance_variable_set(:@broadcastable, broadcastable)
+      end
+    end
+end
@@ -0,0 +1,41 @@
+require 'config'
+
+class GraphQL_RequestTest < GraphQL::TestCase
+  DESCRIBED_CLASS = Rails::GraphQL::Request
+
+  module Extension
+    module Component_Field
+      def extended?
+        true
+      end
+    end
+  end
+
+  def teardown
+    DESCRIBED_CLASS::SPECIALIZED_CLASSES.clear
+  end
+
+  def test_specialized_class
+    field = DESCRIBED_CLASS::Component::Field
+    first, second = DESCRIBED_CLASS.allocate, DESCRIBED_CLASS.allocate
+    assert_same(field, first.send(:specialized_class, field))
+
+    first.extend(Extension)
+    second.extend(Extension)
+
+    klass = first.send(:specialized_class, field)
+    assert_operator(klass, :<, field)
+    assert_includes(klass.ancestors, Extension::Component_Field)
+    assert_same(field, klass.specialized_from)
+    assert_equal(field.name, klass.name)
+
+    assert_same(klass, first.send(:specialized_class, klass))
+    assert_same(klass, second.send(:specialized_class, field))
+    assert_equal(1, DESCRIBED_CLASS::SPECIALIZED_CLASSES.size)
+
+    object = first.build_from_cache(field)
+    assert(object.extended?)
+    assert_same(field, first.unspecialized_class_of(object))
+    assert_same(field, first.unspecialized_class_of(field.allocate))
+  end
+end
@@ -148,6 +148,24 @@ class GraphQL_SourceTest < GraphQL::TestCase
     skip
   end
 
+  def test_prefetch_all
+    threads = Concurrent::Array.new
+    sources = Array.new(3) do
+      double(prefetch_build: -> { threads << Thread.current })
+    end
+
+    described_class.prefetch_all(sources, 2)
+    assert_equal(3, threads.size)
+    refute_includes(threads, Thread.current)
+
+    failing = double(prefetch_build: -> { raise ::ArgumentError, 'failed' })
+    error = assert_raises(::ArgumentError) do
+      described_class.prefetch_all([sources.first, failing], 2)
+    end
+
+    assert_equal('failed', error.message)
+  end
+
   protected
 
     def assert_pending(*items)
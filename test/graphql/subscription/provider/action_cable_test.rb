@@ -0,0 +1,101 @@
+require 'config'
+
+class GraphQL_Subscription_Provider_ActionCableTest < GraphQL::TestCase
+  DESCRIBED_CLASS = Rails::GraphQL::Subscription::Provider::ActionCable
+
+  attr_reader :broadcasts
+
+  def setup
+    @broadcasts = []
+  end
+
+  def test_update_all_shares_executions
+    items = [item('a', 1), item('b', 1), item('c', 2)]
+    fetch = ->(*values) do
+      found = items.select { |item| values.include?(item.sid) || values.include?(item) }
+      found.one? ? found.first : found
+    end
+
+    store = double(Rails::GraphQL::Subscription::Store::Memory.new, fetch: fetch, update!: ->(*) { })
+    executions = []
+    execute = ->(item, **) do
+      executions << item.sid
+      { 'value' => item.sid }
+    end
+
+    object = provider(store: store)
+    object.stub(:execute, execute) do
+      synchronized(object) { object.send(:async_update_all, 'a', 'b', 'c') }
+    end
+
+    assert_equal(%w[a c], executions)
+    assert_equal(%w[rails-graphql:a rails-graphql:b rails-graphql:c], broadcasts.map(&:first))
+
+    shared = broadcasts.first(2)
+    assert_equal('{"result":{"value":"a"},"more":true}', shared.first[1])
+    assert(shared.first[1].equal?(shared.last[1]))
+    assert_equal([nil, nil], shared.map(&:last))
+
+    assert_equal({ 'result' => { 'value' => 'c' }, 'more' => true }, broadcasts.last[1])
+    assert_equal(ActiveSupport::JSON, broadcasts.last.last)
+  end
+
+  def test_wire_round_trip
+    object = provider
+    extra = Marshal.dump([[], { data_for: { 'a' => 1 } }])
+    events = [
+      [:async_update_all, %w[a b], ''],
+      [:async_search_and_update, [], extra],
+      [:custom_method, ['ç'], ''],
+      object.send(:build_event, :async_remove_all, ['c', 1], { x: 1 }),
+    ]
+
+    message = object.send(:encode_events, events)
+    assert(message.start_with?(DESCRIBED_CLASS::WIRE_HEADER))
+    assert_equal(DESCRIBED_CLASS::WIRE_VERSION, message.getbyte(3))
+
+    result = object.send(:decode_events, message)
+    assert_equal([:async_update_all, %w[a b], {}], result[0])
+    assert_equal([:async_search_and_update, [], { data_for: { 'a' => 1 } }], result[1])
+    assert_equal([:custom_method, ['ç'], {}], result[2])
+    assert_equal([:async_remove_all, ['c', 1], { x: 1 }], result[3])
+    assert_equal(Encoding::UTF_8, result[2][1][0].encoding)
+  end
+
+  def test_wire_marshal_fallback
+    message = Marshal.dump([:async_remove, %w[a], {}])
+    assert_equal([[:async_remove, %w[a], {}]], provider.send(:decode_events, message))
+  end
+
+  def test_wire_version_mismatch
+    object = provider
+    message = object.send(:encode_events, [[:async_remove, %w[a], '']])
+    message.setbyte(3, DESCRIBED_CLASS::WIRE_VERSION + 1)
+
+    error = assert_raises(ArgumentError) { object.send(:decode_events, message) }
+    assert_match(/Unsupported version/, error.message)
+  end
+
+  private
+
+    def provider(**xargs)
+      DESCRIBED_CLASS.new(cable: cable, **xargs)
+    end
+
+    def cable
+      list = broadcasts
+      server = double(
+        broadcast: ->(name, message, coder: ActiveSupport::JSON) { list << [name, message, coder] },
+      )
+
+      double(server: server)
+    end
+
+    def item(sid, fingerprint)
+      double(sid: sid, fingerprint: fingerprint, broadcastable?: true, origin: nil)
+    end
+
+    def synchronized(object, &block)
+      object.instance_variable_get(:@mutex).synchronize(&block)
+    end
+end
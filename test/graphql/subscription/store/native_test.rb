@@ -0,0 +1,126 @@
+require 'config'
+
+class GraphQL_Subscription_Store_NativeTest < GraphQL::TestCase
+  DESCRIBED_CLASS = Rails::GraphQL::Subscription::Store::Native
+
+  def test_add
+    store = DESCRIBED_CLASS.new
+
+    assert_equal('a', store.add(item('a')))
+    assert(store.has?('a'))
+    assert_equal(0, store.slots['a'])
+    assert_equal(1, store.index.size)
+
+    assert_raises(ArgumentError) { store.add(item('a')) }
+    assert_raises(ArgumentError) { store.add(item(:b)) }
+    assert_raises(ArgumentError) { store.add(item(1)) }
+    assert_equal(1, store.index.size)
+  end
+
+  def test_remove
+    store = DESCRIBED_CLASS.new
+    store.add(item('a'))
+    store.add(item('b'))
+
+    store.remove('a')
+    refute(store.has?('a'))
+    assert_nil(store.slots['a'])
+    assert_equal(%w[b], store.search(field: :field))
+
+    store.remove('a')
+    store.remove('b')
+    assert_equal(0, store.index.size)
+    assert_empty(store.search(field: :field))
+  end
+
+  def test_search
+    store = DESCRIBED_CLASS.new
+    store.add(item('a'))
+    store.add(item('b', scope: :user))
+    store.add(item('c', args: { id: 2 }))
+    store.add(item('d', field: :other))
+
+    assert_equal(%w[a b c d], store.search.sort)
+    assert_equal(%w[a b c], store.search(field: :field).sort)
+    assert_equal(%w[b], store.search(field: :field, scope: :user))
+    assert_equal(%w[a b], store.search(field: :field, args: { id: 1 }).sort)
+    assert_equal(%w[a b c], store.search(field: :field, args: [{ id: 1 }, { id: 2 }]).sort)
+
+    found = []
+    store.search(field: :other) { |value| found << value }
+    assert_equal(%w[d], found)
+  end
+
+  def test_search_yields_like_memory
+    [DESCRIBED_CLASS, Rails::GraphQL::Subscription::Store::Memory].map do |klass|
+      store = klass.new
+      store.add(item('a'))
+      store.add(item('b', field: :other))
+
+      filtered, all = [], []
+      store.search(field: :field) { |value| filtered << value }
+      store.search { |sid, value| all << [sid, value.sid] }
+      [filtered, all.sort]
+    end.reduce { |native, memory| assert_equal(memory, native) }
+  end
+
+  def test_search_with_zero_scope
+    store = DESCRIBED_CLASS.new
+    store.add(item('a'))
+    store.add(item('b', scope: 0))
+
+    assert_equal(%w[b], store.search(field: :field, scope: 0))
+    assert_equal(%w[a b], store.search(field: :field).sort)
+    refute_equal(store.send(:index_key, 0), store.send(:index_key, nil))
+  end
+
+  def test_search_with_any_key
+    store = DESCRIBED_CLASS.new
+    store.add(item('a', scope: 2**70))
+    store.add(item('b', scope: 1.5))
+    store.add(item('c', scope: -1))
+
+    assert_equal(%w[a], store.search(field: :field, scope: 2**70))
+    assert_equal(%w[b], store.search(field: :field, scope: 1.5))
+    assert_equal(%w[c], store.search(field: :field, scope: -1))
+  end
+
+  def test_slot_reuse
+    store = DESCRIBED_CLASS.new
+    store.add(item('a'))
+    store.add(item('b'))
+    store.add(item('c'))
+
+    store.remove('b')
+    store.remove('a')
+    store.add(item('d'))
+    store.add(item('e'))
+
+    assert_equal(0, store.slots['d'])
+    assert_equal(1, store.slots['e'])
+    assert_equal(%w[c d e], store.search(field: :field).sort)
+  end
+
+  def test_gc_compact
+    skip unless GC.respond_to?(:compact)
+
+    store = DESCRIBED_CLASS.new
+    sids = Array.new(100) { |idx| store.add(item("sid-#{idx}", args: { id: idx % 3 })) }
+    sids.each_slice(2) { |(sid, _)| store.remove(sid) }
+
+    GC.start
+    GC.compact
+
+    expected = sids.each_slice(2).map(&:last)
+    assert_equal(expected.sort, store.search(field: :field).sort)
+    assert_equal(expected.size, store.index.size)
+  end
+
+  private
+
+    def item(sid, field: :field, scope: nil, args: { id: 1 })
+      result = double(sid: sid, field: field, args: args, scope: -> { @scope })
+      result.instance_variable_set(:@scope, scope)
+      result
+    end
+end
@@ -8,10 +8,14 @@ class GraphQL_Type_Scalar_BinaryScalarTest < GraphQL::TestCase
     assert_equal('MQ==', DESCRIBED_CLASS.as_json(1))
     assert_equal('YQ==', DESCRIBED_CLASS.as_json('a'))
     assert_equal('', DESCRIBED_CLASS.as_json(nil))
+    assert_equal(Base64.strict_encode64('a' * 100), DESCRIBED_CLASS.as_json('a' * 100))
   end
 
   def test_deserialize
     file = DESCRIBED_CLASS.deserialize(File.read(FILE_PATH))
     assert_kind_of(ActiveModel::Type::Binary::Data, file)
+
+    value = DESCRIBED_CLASS.deserialize(Base64.encode64('a' * 100))
+    assert_equal('a' * 100, value.to_s)
   end
 end
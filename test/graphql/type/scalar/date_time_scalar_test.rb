@@ -9,6 +9,8 @@ class GraphQL_Type_Scalar_DateTimeScalarTest < GraphQL::TestCase
     refute(DESCRIBED_CLASS.valid_input?(1))
     refute(DESCRIBED_CLASS.valid_input?('abc'))
     refute(DESCRIBED_CLASS.valid_input?(nil))
+    refute(DESCRIBED_CLASS.valid_input?('2020-02-02T10:20:30+25:00'))
+    refute(DESCRIBED_CLASS.valid_input?('2020-02-02T10:20:30-03:60'))
   end
 
   def test_valid_output_ask
@@ -25,5 +27,9 @@ class GraphQL_Type_Scalar_DateTimeScalarTest < GraphQL::TestCase
 
   def test_deserialize
     assert_kind_of(Time, DESCRIBED_CLASS.deserialize('2020-02-02T00:00:00-03:00'))
+
+    value = '2020-02-02T10:20:30.123456Z'
+    assert_equal(Time.iso8601(value), DESCRIBED_CLASS.deserialize(value))
+    assert_equal('2020-02-02T10:20:30Z', DESCRIBED_CLASS.as_json(Time.iso8601(value)))
   end
 end
@@ -95,6 +95,27 @@ class GraphQL_TypeMapTest < GraphQL::TestCase
     end
   end
 
+  def test_snapshot_bang
+    subject.stub_ivar(:@index, SAMPLE_INDEX) do
+      subject.stub(:load_dependencies!, nil) do
+        subject.snapshot!
+        assert(subject.snapshot?)
+
+        assert_nil(subject.fetch(:number))
+        assert_nil(subject.fetch(:number, base_class: :Other))
+
+        assert_equal(1, subject.fetch(:string))
+        assert_equal(2, subject.fetch(:string, namespaces: :other))
+        assert_equal(3, subject.fetch(:number, namespaces: Set[:other]))
+        assert_equal(4, subject.fetch(:boolean, namespaces: :other))
+        assert_nil(subject.fetch(:boolean, namespaces: :other, exclusive: true))
+
+        subject.instance_variable_get(:@revision).increment
+        refute(subject.snapshot?)
+      end
+    end
+  end
+
   def test_exist_ask
     stub_dig do
       assert(subject.exist?(:string))
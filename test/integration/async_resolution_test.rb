@@ -0,0 +1,90 @@
+require 'integration/config'
+
+class Integration_AsyncResolutionTest < GraphQL::IntegrationTestCase
+  class SCHEMA < GraphQL::Schema
+    namespace :async_resolution
+
+    configure do |config|
+      config.enable_string_collector = false
+      config.default_response_format = :json
+      config.async_field_resolution = true
+    end
+
+    query_fields do
+      field(:future1, :string)
+      field(:future2, :string)
+      field(:thread1, :string).resolve { Thread.new { 'Ok 3' } }
+      field(:failed1, :string).resolve { Concurrent::Promises.rejected_future(StandardError.new('Failed')) }
+      field(:cached1, :string)
+      field(:plain1, :string).resolve { 'Ok 4' }
+    end
+  end
+
+  def test_future_resolvers
+    started = Concurrent::Event.new
+    first = -> { Concurrent::Promises.future { started.wait(1) ? 'Ok 1' : 'Late' } }
+    second = -> { Concurrent::Promises.future { started.set && 'Ok 2' } }
+
+    stub_resolver(:future1, first) do
+      stub_resolver(:future2, second) do
+        result = { future1: 'Ok 1', future2: 'Ok 2', plain1: 'Ok 4' }
+        assert_result(result, '{ future1 future2 plain1 }', dig: 'data')
+      end
+    end
+  end
+
+  def test_thread_and_promise_resolvers
+    assert_result({ thread1: 'Ok 3', plain1: 'Ok 4' }, '{ thread1 plain1 }', dig: 'data')
+    skip unless defined?(::ActiveRecord::Promise)
+
+    promise = -> { ::ActiveRecord::Promise.wrap('Ok 1') }
+    stub_resolver(:future1, promise) do
+      assert_result({ future1: 'Ok 1', plain1: 'Ok 4' }, '{ future1 plain1 }', dig: 'data')
+    end
+  end
+
+  def test_rejected_future
+    result = execute('{ failed1 plain1 }')
+
+    assert_equal({ 'failed1' => nil, 'plain1' => 'Ok 4' }, result['data'])
+    assert_equal('Failed', result.dig('errors', 0, 'message'))
+    assert_equal(['failed1'], result.dig('errors', 0, 'path'))
+  end
+
+  def test_ordering
+    calls = []
+    slow = -> { calls << :future1; Concurrent::Promises.future { sleep(0.01) && 'Ok 1' } }
+    fast = -> { calls << :future2; Concurrent::Promises.fulfilled_future('Ok 2') }
+
+    stub_resolver(:future1, slow) do
+      stub_resolver(:future2, fast) do
+        result = execute('{ future2 future1 plain1 }')
+        assert_equal(%w[future2 future1 plain1], result['data'].keys)
+        assert_equal(%i[future2 future1], calls)
+      end
+    end
+  end
+
+  def test_cached_fields_are_not_resolved_ahead
+    calls = 0
+    resolver = -> { calls += 1; 'Ok 5' }
+
+    stub_resolver(:cached1, resolver) do
+      document = '{ cached1 @cached(ttl: 60) plain1 }'
+      assert_result({ cached1: 'Ok 5', plain1: 'Ok 4' }, document, dig: 'data')
+      assert_result({ cached1: 'Ok 5', plain1: 'Ok 4' }, document, dig: 'data')
+      assert_equal(1, calls)
+    end
+  end
+
+  protected
+
+    def stub_resolver(name, block)
+      field = SCHEMA.query_field(name)
+      callback = Rails::GraphQL::Callback.new(field, :resolve, &block)
+
+      field.get_reset_ivar(:@dynamic_resolver, true) do
+        field.stub_ivar(:@resolver, callback) { yield }
+      end
+    end
+end
@@ -0,0 +1,88 @@
+require 'integration/config'
+require 'active_support/testing/time_helpers'
+
+class Integration_CachedDirectiveTest < GraphQL::IntegrationTestCase
+  include ActiveSupport::Testing::TimeHelpers
+
+  CALLS = Hash.new(0)
+
+  class SCHEMA < GraphQL::Schema
+    namespace :cached_directive
+
+    configure do |config|
+      config.default_response_format = :json
+      config.cache = ActiveSupport::Cache::MemoryStore.new
+    end
+
+    query_fields do
+      field(:counter, :int, arguments: arg(:name, :string)).resolve do
+        CALLS[argument(:name)] += 1
+      end
+
+      field(:failed, :int).resolve { raise 'Failed' }
+    end
+  end
+
+  def setup
+    super
+    CALLS.clear
+    SCHEMA.config.cache.clear
+  end
+
+  def test_cache_hit
+    document = '{ counter(name: "a") @cached(ttl: 60) }'
+
+    assert_result({ counter: 1 }, document, dig: 'data')
+    assert_result({ counter: 1 }, document, dig: 'data')
+    assert_equal(1, CALLS['a'])
+
+    assert_equal('{"data":{"counter":2}}', execute(document, as: :string))
+    assert_equal('{"data":{"counter":2}}', execute(document, as: :string))
+    assert_equal(2, CALLS['a'])
+  end
+
+  def test_cache_miss
+    assert_result({ counter: 1 }, '{ counter(name: "a") @cached(ttl: 60) }', dig: 'data')
+    assert_result({ counter: 1 }, '{ counter(name: "b") @cached(ttl: 60) }', dig: 'data')
+    assert_result({ counter: 2 }, '{ counter(name: "a") }', dig: 'data')
+    assert_result({ x: 3 }, '{ x: counter(name: "a") @cached(ttl: 60) }', dig: 'data')
+
+    assert_nil(execute('{ failed @cached }').dig('data', 'failed'))
+    assert_nil(execute('{ failed @cached }').dig('data', 'failed'))
+    assert_equal(2, CALLS.size)
+  end
+
+  def test_cache_with_alias
+    document = '{ x: counter(name: "a") @cached(ttl: 60) counter(name: "b") }'
+    result = { x: 1, counter: 1 }
+
+    assert_result(result, document, dig: 'data')
+    assert_result(result.merge(counter: 2), document, dig: 'data')
+    assert_equal(1, CALLS['a'])
+
+    document = '{ y: counter(name: "c") @cached(ttl: 60) counter(name: "d") }'
+    assert_equal('{"data":{"y":1,"counter":1}}', execute(document, as: :string))
+    assert_equal('{"data":{"y":1,"counter":2}}', execute(document, as: :string))
+    assert_equal(1, CALLS['c'])
+  end
+
+  def test_cache_expiry
+    document = '{ counter(name: "a") @cached(ttl: 60) }'
+
+    assert_result({ counter: 1 }, document, dig: 'data')
+    travel(30.seconds) { assert_result({ counter: 1 }, document, dig: 'data') }
+    travel(61.seconds) { assert_result({ counter: 2 }, document, dig: 'data') }
+  end
+
+  def test_document_digest
+    request = Rails::GraphQL::Request.new(SCHEMA)
+    request.instance_variable_set(:@cache, {})
+
+    request.instance_variable_set(:@document, ::GQLParser.parse_execution('{ counter }'))
+    first = request.document_digest
+
+    request.instance_variable_set(:@cache, {})
+    request.instance_variable_set(:@document, ::GQLParser.parse_execution("{\n  counter,\n}"))
+    assert_equal(first, request.document_digest)
+  end
+end
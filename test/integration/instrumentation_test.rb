@@ -0,0 +1,62 @@
+require 'integration/config'
+
+class Integration_InstrumentationTest < GraphQL::IntegrationTestCase
+  EVENTS = %w[parse organize prepare resolve serialize].map { |name| "#{name}.graphql" }.freeze
+
+  class SCHEMA < GraphQL::Schema
+    namespace :instrumentation
+
+    configure do |config|
+      config.enable_string_collector = false
+      config.default_response_format = :json
+      config.resolver_timings = true
+    end
+
+    query_fields do
+      field(:a, :string).resolve { 'Ok 1' }
+      field(:b, :string, array: true).resolve { %w[Ok 2] }
+    end
+  end
+
+  def test_stage_events
+    document = '{ a b }'
+    events = instrumented { assert_result({ a: 'Ok 1', b: %w[Ok 2] }, document, dig: 'data') }
+    assert_equal(%w[parse.graphql organize.graphql resolve.graphql serialize.graphql], events.map(&:first))
+
+    parse = events.assoc('parse.graphql').last
+    assert_equal(document, parse[:document])
+    assert_equal(%i[bytes tokens nodes allocations nanoseconds], parse[:stats].keys)
+    assert_equal(document.bytesize, parse[:stats][:bytes])
+
+    assert_kind_of(Rails::GraphQL::Request, events.assoc('organize.graphql').last[:request])
+    assert_equal(:as_json, events.assoc('serialize.graphql').last[:format])
+
+    resolvers = events.assoc('resolve.graphql').last[:resolvers]
+    assert_equal(%w[_Query.a _Query.b], resolvers.keys.sort)
+    assert_equal(1, resolvers.dig('_Query.a', :count))
+    assert_equal(1, resolvers.dig('_Query.b', :buckets).sum)
+  end
+
+  def test_without_resolver_timings
+    SCHEMA.config.resolver_timings = false
+    events = instrumented { execute('{ a }') }
+
+    assert(events.assoc('resolve.graphql'))
+    refute(events.assoc('resolve.graphql').last.key?(:resolvers))
+  ensure
+    SCHEMA.config.resolver_timings = true
+  end
+
+  protected
+
+    def instrumented
+      events = []
+      callback = ->(name, *, payload) { events << [name, payload] }
+      subscriptions = EVENTS.map { |name| ActiveSupport::Notifications.subscribe(name, callback) }
+
+      yield
+      events
+    ensure
+      subscriptions.each { |item| ActiveSupport::Notifications.unsubscribe(item) }
+    end
+end
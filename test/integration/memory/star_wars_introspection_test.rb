@@ -12,6 +12,55 @@ class Integration_Memory_StarWarsIntrospectionTest < GraphQL::IntegrationTestCas
     assert(SCHEMA.has_field?(:query, :__type))
   end
 
+  def test_warm_introspection
+    SCHEMA.warm_introspection!
+    payloads = []
+
+    subscriber = ActiveSupport::Notifications.subscribe('request.graphql') do |*, payload|
+      payloads << payload
+    end
+
+    first = execute(Rails::GraphQL::Introspection::STANDARD_QUERY)
+    second = execute(Rails::GraphQL::Introspection::STANDARD_QUERY)
+
+    assert(payloads.all? { |payload| payload[:introspection] })
+    assert_equal(first, second)
+    assert_nil(first['errors'])
+  ensure
+    ActiveSupport::Notifications.unsubscribe(subscriber) if subscriber
+  end
+
+  def test_introspection_documents
+    key = ->(document) do
+      request = Rails::GraphQL::Request.new(SCHEMA)
+      request.instance_variable_set(:@document, ::GQLParser.parse_execution(document))
+      request.send(:introspection_document?)
+    end
+
+    assert(key.call('{ __schema { queryType { name } } }'))
+    assert(key.call('{ __type(name: "Droid") { name } a: __schema { __typename } }'))
+    refute(key.call('{ hero { name __typename } }'))
+    refute(key.call('{ __schema { queryType { name } } hero { name } }'))
+    refute(key.call('{ ...Introspection } fragment Introspection on _Query { __schema { __typename } }'))
+    refute(key.call('query($name: String!) { __type(name: $name) { name } }'))
+  end
+
+  def test_introspection_cache_eviction
+    SCHEMA.instance_variable_set(:@introspection_version, nil)
+    Rails::GraphQL::Introspection.stub_const(:CACHE_SIZE, 2) do
+      SCHEMA.cache_introspection(:a, 1)
+      SCHEMA.cache_introspection(:b, 2)
+      assert_equal(1, SCHEMA.cached_introspection(:a))
+
+      SCHEMA.cache_introspection(:c, 3)
+      assert_equal(1, SCHEMA.cached_introspection(:a))
+      assert_nil(SCHEMA.cached_introspection(:b))
+      assert_equal(3, SCHEMA.cached_introspection(:c))
+    end
+  ensure
+    SCHEMA.instance_variable_set(:@introspection_version, nil)
+  end
+
   def test_query_schema_types
     types = named_list(*%w[Boolean Character Droid Episode Float Human ID Int String
       _Mutation _Query __Directive __DirectiveLocation __EnumValue __Field __InputValue
@@ -132,6 +132,30 @@ class Integration_Memory_StarWarsQueryTest < GraphQL::IntegrationTestCase
     GQL
   end
 
+  def test_query_with_variables_as_string
+    vader = { name: 'Darth Vader', greeting: 'Be gone Luke!' }
+    document = <<~GQL
+      query first($name: String!) { human(id: "1001") { name greeting(name: $name) } }
+      query second($name: Boolean!) { hero @include(if: $name) { name } }
+    GQL
+
+    variables = '{"name": "Luke"}'
+    assert_result({ data: { human: vader } }, document, variables: variables, operation_name: 'first')
+
+    result = execute(document, variables: variables, operation_name: 'second')
+    assert_equal([<<~MSG.squish], result['errors'].map { |item| item['message'] })
+      Invalid arguments for second query: Invalid value "Luke" provided to $name variable.
+    MSG
+
+    # Each operation coerces the variables against its own definitions
+    result = execute(document, variables: variables)
+    assert_equal('Darth Vader', result.dig('data', 'first', 'human', 'name'))
+    assert_equal(1, result['errors'].size)
+
+    result = execute(document, variables: '{"name": 1')
+    assert_equal(['Variables parser error: unexpected "EOF" at 10'], result['errors'].map { |item| item['message'] })
+  end
+
   def test_query_with_fragment
     luke = { name: 'Luke Skywalker', homePlanet: 'Tatooine' }
     leia = { name: 'Leia Organa', homePlanet: 'Alderaan' }
@@ -175,6 +199,43 @@ class Integration_Memory_StarWarsQueryTest < GraphQL::IntegrationTestCase
     GQL
   end
 
+  def test_query_with_fragment_and_variable_slots_across_operations
+    first = { human: { name: 'Darth Vader', greeting: 'Be gone Luke!' } }
+    second = { human: { name: 'Darth Vader', greeting: 'Be gone Leia!' } }
+    document = <<~GQL
+      query first($id: ID! = 1001, $name: String! = "Luke") {
+        human(id: $id) { ...HumanFragment }
+      }
+
+      query second($name: String! = "Leia") {
+        human(id: "1001") { ...GreetingFragment }
+      }
+
+      fragment HumanFragment on Human { ...GreetingFragment }
+      fragment GreetingFragment on Human { name greeting(name: $name) }
+    GQL
+
+    assert_result({ data: { first: first, second: second } }, document)
+
+    SCHEMA.config.concurrent_multi_query = 2
+    assert_result({ data: { first: first, second: second } }, document)
+  ensure
+    SCHEMA.config.delete(:concurrent_multi_query)
+  end
+
+  def test_concurrent_queries
+    SCHEMA.config.concurrent_multi_query = 2
+
+    luke = { human: { name: 'Luke Skywalker' } }
+    r2d2 = { hero: { name: 'R2-D2' } }
+    assert_result({ data: { luke: luke, r2d2: r2d2 } }, <<~GQL)
+      query luke { human(id: "1000") { name } }
+      query r2d2 { hero { name } }
+    GQL
+  ensure
+    SCHEMA.config.delete(:concurrent_multi_query)
+  end
+
   def test_get_typename_field
     assert_result({ data: { hero: { __typename: 'Droid', name: 'R2-D2' } } }, <<~GQL)
       query CheckTypeOfR2 { hero { __typename name } }
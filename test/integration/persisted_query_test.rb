@@ -12,6 +12,7 @@ class Integration_PersistedQueryTest < GraphQL::IntegrationTestCase
     query_fields do
       field(:one, :string).resolve { 'One!' }
       field(:two, :string).resolve { 'Two!' }
+      field(:echo, :string, arguments: arg(:value, :string, null: false)).resolve { argument(:value) }
     end
 
     class_attribute :cache, instance_writer: false, default: {}
@@ -72,8 +73,57 @@ class Integration_PersistedQueryTest < GraphQL::IntegrationTestCase
     assert_equal('One!', result.dig('data', 'one'))
   end
 
+  def test_hard_cached_query
+    SCHEMA.config.hard_cache_operations = true
+
+    assert_result('One!', :one)
+    assert_equal(1, hard_cache_keys.size)
+    assert_result('One!', :one)
+  ensure
+    SCHEMA.config.delete(:hard_cache_operations)
+  end
+
+  def test_hard_cached_query_with_bad_variables
+    SCHEMA.config.hard_cache_operations = true
+    query = 'query($value: String!) { echo(value: $value) }'
+
+    result = GraphQL.execute(query, variables: { value: nil }, schema: SCHEMA)
+    assert_nil(result.dig('data', 'echo'))
+    refute_empty(result['errors'])
+    assert_empty(hard_cache_keys)
+
+    result = GraphQL.execute(query, variables: { value: 'Ok!' }, schema: SCHEMA)
+    assert_equal('Ok!', result.dig('data', 'echo'))
+    assert_equal(1, hard_cache_keys.size)
+
+    result = GraphQL.execute(query, variables: { value: 'Ok Again!' }, schema: SCHEMA)
+    assert_equal('Ok Again!', result.dig('data', 'echo'))
+  ensure
+    SCHEMA.config.delete(:hard_cache_operations)
+  end
+
+  def test_hard_cached_query_with_string_variables
+    SCHEMA.config.hard_cache_operations = true
+    query = 'query($value: String!) { echo(value: $value) }'
+
+    result = GraphQL.execute(query, variables: '{"value": "Ok!"}', schema: SCHEMA)
+    assert_equal('Ok!', result.dig('data', 'echo'))
+    assert_equal(1, hard_cache_keys.size)
+
+    # The variables are coerced even when the operation comes from the cache
+    result = GraphQL.execute(query, variables: '{"value": 1}', schema: SCHEMA)
+    assert_nil(result.dig('data', 'echo'))
+    refute_empty(result['errors'])
+  ensure
+    SCHEMA.config.delete(:hard_cache_operations)
+  end
+
   private
 
+    def hard_cache_keys
+      SCHEMA.cache.keys.select { |key| key.start_with?('hard/') }
+    end
+
     def cache_key(key = nil, version = nil)
       key ||= SCHEMA.config.cache_prefix + SecureRandom.uuid
       Rails::GraphQL::CacheKey.new(key, version)
@@ -81,4 +81,105 @@ class Integration_SQLite_StarWarsQueryTest < GraphQL::IntegrationTestCase
       query AllBases($order: String!) { liteBases(order: $order) { name } }
     GQL
   end
+
+  def test_planned_columns
+    bases = named_list('Death Star', 'Shield Generator', 'Headquarters')
+    faction = { name: 'Galactic Empire', bases: bases }
+
+    queries = with_select_columns do
+      assert_result({ data: { liteFaction: faction } }, <<~GQL)
+        query EmpireBases { liteFaction(id: "2") { name bases { name } } }
+      GQL
+    end
+
+    factions = queries.find { |sql| sql.include?('FROM "lite_factions"') }
+    refute_includes(factions, '*')
+    assert_includes(factions, 'name')
+
+    bases = queries.find { |sql| sql.include?('FROM "lite_bases"') }
+    refute_includes(bases, '*')
+    assert_includes(bases, 'faction_id')
+    refute_includes(bases, 'planet')
+  end
+
+  def test_planned_columns_with_all_columns
+    queries = with_select_columns do
+      assert_result({ data: { liteFaction: { id: '2', name: 'Galactic Empire' } } }, <<~GQL)
+        query EmpireFaction { liteFaction(id: "2") { id name } }
+      GQL
+    end
+
+    factions = queries.find { |sql| sql.include?('FROM "lite_factions"') }
+    assert_includes(factions, '"lite_factions".*')
+  end
+
+  def test_keyset_page
+    ships_source.stub(:keyset_pagination, 2) do
+      assert_equal([1, 2], keyset_ids)
+      assert_equal([3, 4], keyset_ids(after: '2'))
+      assert_equal([4], keyset_ids(first: 1, after: '3'))
+      assert_equal([7, 8], keyset_ids(first: 5, after: '6'))
+      assert_equal([], keyset_ids(after: '8'))
+    end
+
+    ships_source.stub(:keyset_pagination, true) do
+      assert_equal([5, 6, 7, 8], keyset_ids(after: '4'))
+      assert_raises(ArgumentError) { keyset_ids(first: -1) }
+    end
+  end
+
+  def test_keyset_page_with_composite_cursor
+    ships_source.stub(:primary_key, %w[faction_id id]) do
+      ships_source.stub(:keyset_pagination, 2) do
+        assert_equal([5, 6], keyset_ids(after: '1,4'))
+        assert_equal([7, 8], keyset_ids(after: '2,6'))
+        assert_raises(ArgumentError) { keyset_ids(after: '1') }
+      end
+    end
+  end
+
+  def test_keyset_conditions
+    columns = %w[faction_id id]
+    row = ['("lite_ships"."faction_id", "lite_ships"."id") > (?, ?)', 1, 4]
+    expanded = [
+      '("lite_ships"."faction_id" > ?) OR ("lite_ships"."faction_id" = ? AND "lite_ships"."id" > ?)',
+      1, 1, 4,
+    ]
+
+    assert_equal(row, ships_source.keyset_condition(columns, [1, 4]))
+    assert_equal([5, 6, 7, 8], LiteShip.where(row).order(:id).pluck(:id))
+
+    %w[PostgreSQL Mysql2].each { |name| Rails::GraphQL.enable_ar_adapter(name) }
+    ships_source.stub(:adapter_name, 'PostgreSQL') do
+      assert_equal(row, ships_source.keyset_condition(columns, [1, 4]))
+    end
+
+    ships_source.stub(:adapter_name, 'Mysql2') do
+      assert_equal(expanded, ships_source.keyset_condition(columns, [1, 4]))
+      assert_equal([5, 6, 7, 8], LiteShip.where(expanded).order(:id).pluck(:id))
+    end
+  end
+
+  protected
+
+    def ships_source
+      StartWarsSqliteSchema.const_get(:NestedTypes)::LiteShipSource
+    end
+
+    def keyset_ids(**args)
+      source = ships_source.allocate
+      source.instance_variable_set(:@event, double(argument: ->(name) { args[name] }))
+      source.send(:keyset_page, LiteShip.all).pluck(:id)
+    end
+
+    def with_select_columns
+      queries = []
+      callback = ->(*, payload) { queries << payload[:sql] unless payload[:name] == 'SCHEMA' }
+
+      Rails::GraphQL::Source::ActiveRecordSource.select_columns = true
+      ActiveSupport::Notifications.subscribed(callback, 'sql.active_record') { yield }
+      queries
+    ensure
+      Rails::GraphQL::Source::ActiveRecordSource.select_columns = false
+    end
 end
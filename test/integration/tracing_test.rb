@@ -0,0 +1,86 @@
+require 'integration/config'
+
+class Integration_TracingTest < GraphQL::IntegrationTestCase
+  class SCHEMA < GraphQL::Schema
+    namespace :tracing
+
+    configure do |config|
+      config.enable_string_collector = false
+      config.default_response_format = :json
+      config.tracing_sample_rate = 1
+    end
+
+    query_fields do
+      field(:a, :string).resolve { 'Ok 1' }
+      field(:b, :int, array: true, null: false).resolve { [1, 2] }
+    end
+  end
+
+  def teardown
+    SCHEMA.config.tracing_sample_rate = 1
+    SCHEMA.config.delete(:tracing_in_extensions)
+    super
+  end
+
+  def test_tracing_format
+    traces = traced { assert_result({ a: 'Ok 1', b: [1, 2] }, '{ a b }', dig: 'data') }
+    assert_equal(1, traces.size)
+
+    trace = traces.first
+    assert_equal(1, trace[:version])
+    assert_kind_of(Integer, trace[:duration])
+    assert_operator(Time.iso8601(trace[:endTime]), :>=, Time.iso8601(trace[:startTime]))
+
+    resolvers = trace.dig(:execution, :resolvers)
+    assert_equal(%w[a b], resolvers.map { |item| item[:fieldName] })
+    assert_equal(%w[String [Int]!], resolvers.map { |item| item[:returnType] })
+    assert_equal(%w[_Query _Query], resolvers.map { |item| item[:parentType] })
+    assert_equal(%w[a b], resolvers.map { |item| item[:path].last })
+
+    resolvers.each do |item|
+      assert_equal(%i[path parentType fieldName returnType startOffset duration], item.keys)
+      assert_operator(item[:startOffset], :>=, 0)
+      assert_operator(item[:duration], :<=, trace[:duration])
+    end
+
+    result = execute('{ a }')
+    assert_equal(1, result.dig('extensions', 'tracing', 'version'))
+    assert_equal(['a'], result.dig('extensions', 'tracing', 'execution', 'resolvers').map { |item| item['fieldName'] })
+  end
+
+  def test_tracing_sample_rate
+    SCHEMA.config.tracing_sample_rate = 0
+    assert_empty(traced { refute(execute('{ a }').key?('extensions')) })
+
+    SCHEMA.config.tracing_sample_rate = 1
+    assert_equal(3, traced { 3.times { execute('{ a }') } }.size)
+  end
+
+  def test_tracing_without_extensions
+    SCHEMA.config.tracing_in_extensions = false
+    traces = traced { refute(execute('{ a }').key?('extensions')) }
+    assert_equal(1, traces.size)
+  end
+
+  def test_tracing_only_executions
+    request = Rails::GraphQL::Request.new(SCHEMA)
+    traces = traced do
+      request.compile('{ a }')
+      assert_nil(request.tracer)
+
+      assert(request.valid?('{ a }'))
+      assert_nil(request.tracer)
+    end
+
+    assert_empty(traces)
+  end
+
+  protected
+
+    def traced
+      traces = []
+      callback = ->(*, payload) { traces << payload[:trace] }
+      ActiveSupport::Notifications.subscribed(callback, 'trace.graphql') { yield }
+      traces
+    end
+end